@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "../libSimpleLogger.pdb"
+  "../libSimpleLogger.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SimpleLogger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SimpleLoggerLib.dir/simple_logger.cpp.o"
+  "CMakeFiles/SimpleLoggerLib.dir/simple_logger.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SimpleLoggerLib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
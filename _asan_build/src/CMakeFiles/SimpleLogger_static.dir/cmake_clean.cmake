@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "../libSimpleLogger_static.a"
+  "../libSimpleLogger_static.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SimpleLogger_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests
+# Build directory: /root/repo/_asan_build/src/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("file_test")
+subdirs("stream_test")
+subdirs("batch_test")
+subdirs("context_test")
+subdirs("sink_test")
+subdirs("clock_test")
+subdirs("log_stream_test")
+subdirs("pattern_test")
+subdirs("block_file_test")
+subdirs("inline_test")
+subdirs("alloc_test")
+subdirs("delivery_test")
+subdirs("multi_line_test")
+subdirs("profile_test")
+subdirs("span_test")
+subdirs("diagnostic_context_test")
+subdirs("console_test")
+subdirs("unix_socket_test")
+subdirs("shutdown_test")
+subdirs("shared_memory_test")
+subdirs("compressed_file_test")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/alloc_test"
+  "../../../tests/alloc_test.pdb"
+  "CMakeFiles/alloc_test.dir/alloc_test.cpp.o"
+  "CMakeFiles/alloc_test.dir/alloc_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/alloc_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/batch_test"
+  "../../../tests/batch_test.pdb"
+  "CMakeFiles/batch_test.dir/batch_test.cpp.o"
+  "CMakeFiles/batch_test.dir/batch_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batch_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/collapse_timestamp_test"
+  "../../../tests/collapse_timestamp_test.pdb"
+  "CMakeFiles/collapse_timestamp_test.dir/collapse_timestamp_test.cpp.o"
+  "CMakeFiles/collapse_timestamp_test.dir/collapse_timestamp_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/collapse_timestamp_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
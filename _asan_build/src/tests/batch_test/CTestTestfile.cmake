@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests/batch_test
+# Build directory: /root/repo/_asan_build/src/tests/batch_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(batch_test "/root/repo/_asan_build/tests/batch_test")
+set_tests_properties(batch_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/batch_test/CMakeLists.txt;9;add_test;/root/repo/src/tests/batch_test/CMakeLists.txt;0;")
+add_test(collapse_test "/root/repo/_asan_build/tests/collapse_test")
+set_tests_properties(collapse_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/batch_test/CMakeLists.txt;14;add_test;/root/repo/src/tests/batch_test/CMakeLists.txt;0;")
+add_test(collapse_timestamp_test "/root/repo/_asan_build/tests/collapse_timestamp_test")
+set_tests_properties(collapse_timestamp_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/batch_test/CMakeLists.txt;19;add_test;/root/repo/src/tests/batch_test/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/block_file_test"
+  "../../../tests/block_file_test.pdb"
+  "CMakeFiles/block_file_test.dir/block_file_test.cpp.o"
+  "CMakeFiles/block_file_test.dir/block_file_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/block_file_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
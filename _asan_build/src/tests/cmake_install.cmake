@@ -0,0 +1,70 @@
+# Install script for directory: /root/repo/src/tests
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Debug")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/_asan_build/src/tests/file_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/stream_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/batch_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/context_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/sink_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/clock_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/log_stream_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/pattern_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/block_file_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/inline_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/alloc_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/delivery_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/multi_line_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/profile_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/span_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/diagnostic_context_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/console_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/unix_socket_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/shutdown_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/shared_memory_test/cmake_install.cmake")
+  include("/root/repo/_asan_build/src/tests/compressed_file_test/cmake_install.cmake")
+
+endif()
+
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/compressed_file_test"
+  "../../../tests/compressed_file_test.pdb"
+  "CMakeFiles/compressed_file_test.dir/compressed_file_test.cpp.o"
+  "CMakeFiles/compressed_file_test.dir/compressed_file_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/compressed_file_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
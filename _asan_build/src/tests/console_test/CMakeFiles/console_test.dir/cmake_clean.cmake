@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/console_test"
+  "../../../tests/console_test.pdb"
+  "CMakeFiles/console_test.dir/console_test.cpp.o"
+  "CMakeFiles/console_test.dir/console_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/console_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
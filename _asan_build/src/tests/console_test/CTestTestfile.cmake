@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests/console_test
+# Build directory: /root/repo/_asan_build/src/tests/console_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(console_test "/root/repo/_asan_build/tests/console_test")
+set_tests_properties(console_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/console_test/CMakeLists.txt;9;add_test;/root/repo/src/tests/console_test/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/context_test"
+  "../../../tests/context_test.pdb"
+  "CMakeFiles/context_test.dir/context_test.cpp.o"
+  "CMakeFiles/context_test.dir/context_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/context_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/delivery_test"
+  "../../../tests/delivery_test.pdb"
+  "CMakeFiles/delivery_test.dir/delivery_test.cpp.o"
+  "CMakeFiles/delivery_test.dir/delivery_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/delivery_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/diagnostic_context_test"
+  "../../../tests/diagnostic_context_test.pdb"
+  "CMakeFiles/diagnostic_context_test.dir/diagnostic_context_test.cpp.o"
+  "CMakeFiles/diagnostic_context_test.dir/diagnostic_context_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/diagnostic_context_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests/diagnostic_context_test
+# Build directory: /root/repo/_asan_build/src/tests/diagnostic_context_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(diagnostic_context_test "/root/repo/_asan_build/tests/diagnostic_context_test")
+set_tests_properties(diagnostic_context_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/diagnostic_context_test/CMakeLists.txt;9;add_test;/root/repo/src/tests/diagnostic_context_test/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/file_test"
+  "../../../tests/file_test.pdb"
+  "CMakeFiles/file_test.dir/file_test.cpp.o"
+  "CMakeFiles/file_test.dir/file_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/file_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
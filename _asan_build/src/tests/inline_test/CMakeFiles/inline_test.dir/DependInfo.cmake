@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/simple_logger.cpp" "src/tests/inline_test/CMakeFiles/inline_test.dir/__/__/simple_logger.cpp.o" "gcc" "src/tests/inline_test/CMakeFiles/inline_test.dir/__/__/simple_logger.cpp.o.d"
+  "/root/repo/src/tests/inline_test/inline_test.cpp" "src/tests/inline_test/CMakeFiles/inline_test.dir/inline_test.cpp.o" "gcc" "src/tests/inline_test/CMakeFiles/inline_test.dir/inline_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../tests/inline_test"
+  "../../../tests/inline_test.pdb"
+  "CMakeFiles/inline_test.dir/__/__/simple_logger.cpp.o"
+  "CMakeFiles/inline_test.dir/__/__/simple_logger.cpp.o.d"
+  "CMakeFiles/inline_test.dir/inline_test.cpp.o"
+  "CMakeFiles/inline_test.dir/inline_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/inline_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
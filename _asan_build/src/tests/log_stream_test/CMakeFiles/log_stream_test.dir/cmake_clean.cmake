@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/log_stream_test"
+  "../../../tests/log_stream_test.pdb"
+  "CMakeFiles/log_stream_test.dir/log_stream_test.cpp.o"
+  "CMakeFiles/log_stream_test.dir/log_stream_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/log_stream_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
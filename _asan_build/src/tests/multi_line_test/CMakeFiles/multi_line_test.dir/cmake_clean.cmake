@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/multi_line_test"
+  "../../../tests/multi_line_test.pdb"
+  "CMakeFiles/multi_line_test.dir/multi_line_test.cpp.o"
+  "CMakeFiles/multi_line_test.dir/multi_line_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/multi_line_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/pattern_test"
+  "../../../tests/pattern_test.pdb"
+  "CMakeFiles/pattern_test.dir/pattern_test.cpp.o"
+  "CMakeFiles/pattern_test.dir/pattern_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pattern_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
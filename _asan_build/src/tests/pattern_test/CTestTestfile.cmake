@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests/pattern_test
+# Build directory: /root/repo/_asan_build/src/tests/pattern_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(pattern_test "/root/repo/_asan_build/tests/pattern_test")
+set_tests_properties(pattern_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/pattern_test/CMakeLists.txt;9;add_test;/root/repo/src/tests/pattern_test/CMakeLists.txt;0;")
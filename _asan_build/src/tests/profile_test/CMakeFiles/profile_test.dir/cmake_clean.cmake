@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/profile_test"
+  "../../../tests/profile_test.pdb"
+  "CMakeFiles/profile_test.dir/profile_test.cpp.o"
+  "CMakeFiles/profile_test.dir/profile_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/profile_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
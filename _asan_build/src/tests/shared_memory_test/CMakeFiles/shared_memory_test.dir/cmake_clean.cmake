@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/shared_memory_test"
+  "../../../tests/shared_memory_test.pdb"
+  "CMakeFiles/shared_memory_test.dir/shared_memory_test.cpp.o"
+  "CMakeFiles/shared_memory_test.dir/shared_memory_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/shared_memory_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
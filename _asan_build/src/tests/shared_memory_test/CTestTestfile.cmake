@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tests/shared_memory_test
+# Build directory: /root/repo/_asan_build/src/tests/shared_memory_test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(shared_memory_test "/root/repo/_asan_build/tests/shared_memory_test")
+set_tests_properties(shared_memory_test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/tests/shared_memory_test/CMakeLists.txt;9;add_test;/root/repo/src/tests/shared_memory_test/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/shutdown_test"
+  "../../../tests/shutdown_test.pdb"
+  "CMakeFiles/shutdown_test.dir/shutdown_test.cpp.o"
+  "CMakeFiles/shutdown_test.dir/shutdown_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/shutdown_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/sink_test"
+  "../../../tests/sink_test.pdb"
+  "CMakeFiles/sink_test.dir/sink_test.cpp.o"
+  "CMakeFiles/sink_test.dir/sink_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sink_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
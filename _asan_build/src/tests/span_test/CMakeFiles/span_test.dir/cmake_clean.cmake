@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/span_test"
+  "../../../tests/span_test.pdb"
+  "CMakeFiles/span_test.dir/span_test.cpp.o"
+  "CMakeFiles/span_test.dir/span_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/span_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
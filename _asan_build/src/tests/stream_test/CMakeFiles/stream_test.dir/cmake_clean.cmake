@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/stream_test"
+  "../../../tests/stream_test.pdb"
+  "CMakeFiles/stream_test.dir/stream_test.cpp.o"
+  "CMakeFiles/stream_test.dir/stream_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stream_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
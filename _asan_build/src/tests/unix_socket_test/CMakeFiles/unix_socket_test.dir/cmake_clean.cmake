@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../tests/unix_socket_test"
+  "../../../tests/unix_socket_test.pdb"
+  "CMakeFiles/unix_socket_test.dir/unix_socket_test.cpp.o"
+  "CMakeFiles/unix_socket_test.dir/unix_socket_test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unix_socket_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
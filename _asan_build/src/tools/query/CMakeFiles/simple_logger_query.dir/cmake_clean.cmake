@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../simple_logger_query"
+  "../../../simple_logger_query.pdb"
+  "CMakeFiles/simple_logger_query.dir/simple_logger_query.cpp.o"
+  "CMakeFiles/simple_logger_query.dir/simple_logger_query.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simple_logger_query.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../simple_logger_replay"
+  "../../../simple_logger_replay.pdb"
+  "CMakeFiles/simple_logger_replay.dir/simple_logger_replay.cpp.o"
+  "CMakeFiles/simple_logger_replay.dir/simple_logger_replay.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/simple_logger_replay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
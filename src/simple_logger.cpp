@@ -24,524 +24,4291 @@
 
 #include "simple_logger.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
 #include <ctime>
+#include <deque>
+#include <exception>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <stdexcept>
+#include <thread>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <io.h>
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#ifdef SIMPLE_LOGGER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SIMPLE_LOGGER_HAVE_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define SIMPLE_LOGGER_HAVE_TSC
+#endif
+
+// Vector instructions enabled at compile time, e.g. AVX2 with -mavx2
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMPLE_LOGGER_HAVE_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMPLE_LOGGER_HAVE_SSE2
+#endif
+
 namespace juzzlin {
 
-class SimpleLogger::Impl
+namespace {
+
+class FileSink : public SimpleLogger::Sink
+{
+public:
+    FileSink(const std::string & filename, bool append)
+      : m_fileStream { filename, append ? std::ofstream::out | std::ofstream::app : std::ofstream::out }
+    {
+        if (!m_fileStream.is_open()) {
+            throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for write.\n");
+        }
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            m_fileStream.write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+            m_fileStream.put('\n');
+        }
+    }
+
+    void flush() override
+    {
+        m_fileStream.flush();
+    }
+
+private:
+    std::ofstream m_fileStream;
+};
+
+//! Writes the texts of the records as the elements of a Chrome trace event JSON array.
+class TraceFileSink : public SimpleLogger::Sink
+{
+public:
+    explicit TraceFileSink(const std::string & filename)
+      : m_fileStream { filename }
+    {
+        if (!m_fileStream.is_open()) {
+            throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for write.\n");
+        }
+        m_fileStream << "[";
+    }
+
+    ~TraceFileSink() override
+    {
+        m_fileStream << "\n]\n";
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            m_fileStream.write(m_separator, static_cast<std::streamsize>(std::strlen(m_separator)));
+            m_fileStream.write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+            m_separator = ",\n";
+        }
+    }
+
+    void flush() override
+    {
+        m_fileStream.flush();
+    }
+
+private:
+    std::ofstream m_fileStream;
+
+    const char * m_separator = "\n";
+};
+
+class StreamSink : public SimpleLogger::Sink
+{
+public:
+    StreamSink()
+    {
+        for (auto && level : { SimpleLogger::Level::Trace, SimpleLogger::Level::Debug, SimpleLogger::Level::Info }) {
+            m_streams[level] = &std::cout;
+        }
+        for (auto && level : { SimpleLogger::Level::Warning, SimpleLogger::Level::Error, SimpleLogger::Level::Fatal }) {
+            m_streams[level] = &std::cerr;
+        }
+    }
+
+    explicit StreamSink(std::ostream & stream)
+    {
+        for (auto && level : { SimpleLogger::Level::Trace, SimpleLogger::Level::Debug, SimpleLogger::Level::Info,
+                               SimpleLogger::Level::Warning, SimpleLogger::Level::Error, SimpleLogger::Level::Fatal }) {
+            m_streams[level] = &stream;
+        }
+    }
+
+    void setStream(SimpleLogger::Level level, std::ostream & stream)
+    {
+        m_streams[level] = &stream;
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            if (auto && stream = m_streams[record.level]; stream) {
+                stream->write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+                stream->put('\n');
+                if (std::find(m_usedStreams.begin(), m_usedStreams.end(), stream) == m_usedStreams.end()) {
+                    m_usedStreams.push_back(stream);
+                }
+            }
+        }
+    }
+
+    void flush() override
+    {
+        // Flush only the streams that have been written to, as the others might not exist anymore
+        for (auto && stream : m_usedStreams) {
+            stream->flush();
+        }
+        m_usedStreams.clear();
+    }
+
+private:
+    std::map<SimpleLogger::Level, std::ostream *> m_streams;
+
+    std::vector<std::ostream *> m_usedStreams;
+};
+
+//! Captures raw ticks on the hot path and converts them to wall-clock time when the message is rendered.
+class Clock
+{
+public:
+    explicit Clock(SimpleLogger::ClockSource source)
+      : m_source { source }
+    {
+#ifndef CLOCK_REALTIME_COARSE
+        if (m_source == SimpleLogger::ClockSource::RealtimeCoarse) {
+            m_source = SimpleLogger::ClockSource::SystemClock;
+        }
+#endif
+#ifdef SIMPLE_LOGGER_HAVE_TSC
+        if (m_source == SimpleLogger::ClockSource::Tsc) {
+            calibrate();
+        }
+#else
+        if (m_source == SimpleLogger::ClockSource::Tsc) {
+            m_source = SimpleLogger::ClockSource::SystemClock;
+        }
+#endif
+    }
+
+    uint64_t now() const
+    {
+        switch (m_source) {
+#ifdef CLOCK_REALTIME_COARSE
+        case SimpleLogger::ClockSource::RealtimeCoarse: {
+            timespec ts;
+            clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<uint64_t>(ts.tv_nsec);
+        }
+#endif
+#ifdef SIMPLE_LOGGER_HAVE_TSC
+        case SimpleLogger::ClockSource::Tsc:
+            return __rdtsc();
+#endif
+        default:
+            return systemNanoseconds();
+        }
+    }
+
+    std::chrono::system_clock::time_point toTimePoint(uint64_t ticks)
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::system_clock;
+
+        auto nanoseconds = static_cast<int64_t>(ticks);
+#ifdef SIMPLE_LOGGER_HAVE_TSC
+        if (m_source == SimpleLogger::ClockSource::Tsc) {
+            if (ticks > m_tscAnchor && ticks - m_tscAnchor > m_resyncTicks) {
+                resync();
+            }
+            const auto delta = static_cast<double>(static_cast<int64_t>(ticks - m_tscAnchor)) * m_nanosecondsPerTick;
+            nanoseconds = m_nanosecondsAnchor + static_cast<int64_t>(delta);
+        }
+#endif
+        return system_clock::time_point { duration_cast<system_clock::duration>(std::chrono::nanoseconds { nanoseconds }) };
+    }
+
+private:
+    static uint64_t systemNanoseconds()
+    {
+        using std::chrono::duration_cast;
+        return static_cast<uint64_t>(duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+#ifdef SIMPLE_LOGGER_HAVE_TSC
+    void calibrate()
+    {
+        m_tscAnchor = __rdtsc();
+        m_nanosecondsAnchor = static_cast<int64_t>(systemNanoseconds());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        resync();
+    }
+
+    //! Re-anchor to the wall clock and refine the tick rate over the elapsed period.
+    void resync()
+    {
+        const auto tsc = __rdtsc();
+        const auto nanoseconds = static_cast<int64_t>(systemNanoseconds());
+        if (tsc > m_tscAnchor && nanoseconds > m_nanosecondsAnchor) {
+            m_nanosecondsPerTick = static_cast<double>(nanoseconds - m_nanosecondsAnchor) / static_cast<double>(tsc - m_tscAnchor);
+            m_resyncTicks = static_cast<uint64_t>(1e9 / m_nanosecondsPerTick);
+        }
+        m_tscAnchor = tsc;
+        m_nanosecondsAnchor = nanoseconds;
+    }
+
+    uint64_t m_tscAnchor = 0;
+
+    int64_t m_nanosecondsAnchor = 0;
+
+    double m_nanosecondsPerTick = 1.0;
+
+    uint64_t m_resyncTicks = 1'000'000'000;
+#endif
+
+    SimpleLogger::ClockSource m_source;
+};
+
+//! Identity of a thread. Looked up only once per thread.
+struct ThreadInfo
+{
+    uint64_t id;
+
+    //! Interned name, so that queued messages can refer to it after the thread has exited.
+    const std::string * name;
+
+    //! Fields of the mapped diagnostic context, innermost last. \see SimpleLogger::ScopedContext
+    std::vector<SimpleLogger::ScopedContext::Field> fields = {};
+
+    //! The fields as appended to messages, e.g. " {req=42, user=7}". Empty if there are no fields.
+    std::string fieldsText = {};
+};
+
+//! Call the function with each field that isn't overridden by a later field with the same key.
+template<typename Function>
+void forEachField(const std::vector<SimpleLogger::ScopedContext::Field> & fields, Function && function)
+{
+    for (auto field = fields.begin(); field != fields.end(); field++) {
+        if (std::none_of(field + 1, fields.end(), [&field](auto && other) { return other.key == field->key; })) {
+            function(*field);
+        }
+    }
+}
+
+void renderFields(ThreadInfo & thread)
+{
+    thread.fieldsText.clear();
+    forEachField(thread.fields, [&thread](auto && field) {
+        thread.fieldsText += thread.fieldsText.empty() ? " {" : ", ";
+        thread.fieldsText += field.key;
+        thread.fieldsText += '=';
+        thread.fieldsText += field.value;
+    });
+    if (!thread.fieldsText.empty()) {
+        thread.fieldsText += '}';
+    }
+}
+
+const std::string * internThreadName(std::string name)
+{
+    static std::mutex mutex;
+    static std::set<std::string> names;
+    std::lock_guard<std::mutex> lock { mutex };
+    return &*names.insert(std::move(name)).first;
+}
+
+ThreadInfo & currentThread()
+{
+    static const std::string * const noName = internThreadName({});
+    thread_local ThreadInfo info = {
+#ifdef __linux__
+        static_cast<uint64_t>(::syscall(SYS_gettid)),
+#else
+        [] {
+            static std::atomic<uint64_t> nextId { 1 };
+            return nextId++;
+        }(),
+#endif
+        noName
+    };
+    return info;
+}
+
+/*!
+ * Counters of the call sites a thread has logged from in the profiling mode. Only the owning thread
+ * inserts and counts, so no read-modify-write operations are needed. Other threads read the counters
+ * through the atomics. An entry is published by storing its file last.
+ */
+class CallSiteTable
+{
+public:
+    struct Entry
+    {
+        std::atomic<const char *> file { nullptr };
+        std::atomic<unsigned int> line { 0 };
+        std::atomic<const char *> function { nullptr };
+        std::atomic<uint64_t> emitted { 0 };
+        std::atomic<uint64_t> emittedBytes { 0 };
+        std::atomic<uint64_t> filtered { 0 };
+        std::atomic<uint64_t> nanoseconds { 0 };
+    };
+
+    void add(const SimpleLogger::SourceLocation & location, bool emitted, uint64_t bytes, uint64_t nanoseconds)
+    {
+        auto && entry = find(location);
+        if (emitted) {
+            increment(entry.emitted, 1);
+            increment(entry.emittedBytes, bytes);
+        } else {
+            increment(entry.filtered, 1);
+        }
+        increment(entry.nanoseconds, nanoseconds);
+    }
+
+    template<typename Function>
+    void forEach(Function && function) const
+    {
+        for (auto && entry : m_entries) {
+            if (entry.file.load(std::memory_order_acquire)) {
+                function(entry);
+            }
+        }
+        if (m_overflow.file.load(std::memory_order_acquire)) {
+            function(m_overflow);
+        }
+    }
+
+private:
+    static constexpr size_t Capacity = 1024;
+
+    static void increment(std::atomic<uint64_t> & counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    Entry & find(const SimpleLogger::SourceLocation & location)
+    {
+        static const char * const unknown = "?";
+        const auto file = location.file ? location.file : unknown;
+        auto index = (std::hash<const void *> {}(file) ^ (location.line * 0x9e3779b9u)) & (Capacity - 1);
+        for (size_t probe = 0; probe < Capacity; probe++, index = (index + 1) & (Capacity - 1)) {
+            auto && entry = m_entries[index];
+            const auto entryFile = entry.file.load(std::memory_order_relaxed);
+            if (!entryFile) {
+                publish(entry, file, location.line, location.function);
+                return entry;
+            }
+            if (entryFile == file && entry.line.load(std::memory_order_relaxed) == location.line) {
+                return entry;
+            }
+        }
+        if (!m_overflow.file.load(std::memory_order_relaxed)) {
+            publish(m_overflow, "(other call sites)", 0, nullptr);
+        }
+        return m_overflow;
+    }
+
+    static void publish(Entry & entry, const char * file, unsigned int line, const char * function)
+    {
+        entry.line.store(line, std::memory_order_relaxed);
+        entry.function.store(function, std::memory_order_relaxed);
+        entry.file.store(file, std::memory_order_release);
+    }
+
+    std::array<Entry, Capacity> m_entries;
+
+    Entry m_overflow;
+};
+
+//! Call site tables of the live threads and the merged counters of the exited ones.
+struct ProfileRegistry
+{
+    std::mutex mutex;
+
+    std::vector<const CallSiteTable *> tables;
+
+    // Counters of the exited threads by file and line
+    std::map<std::pair<std::string_view, unsigned int>, SimpleLogger::CallSiteStats> retired;
+};
+
+//! Never destroyed, so that threads exiting during static destruction can retire their tables.
+ProfileRegistry & profileRegistry()
+{
+    static auto registry = new ProfileRegistry;
+    return *registry;
+}
+
+//! Add the counters of the table to stats by file and line. Files are compared by content, because
+//! the same file name may have several addresses.
+void mergeCallSites(const CallSiteTable & table, std::map<std::pair<std::string_view, unsigned int>, SimpleLogger::CallSiteStats> & stats)
+{
+    table.forEach([&stats](const CallSiteTable::Entry & entry) {
+        const auto file = entry.file.load(std::memory_order_acquire);
+        const auto line = entry.line.load(std::memory_order_relaxed);
+        auto && site = stats[{ file, line }];
+        site.location = { file, line, entry.function.load(std::memory_order_relaxed) };
+        site.emitted += entry.emitted.load(std::memory_order_relaxed);
+        site.emittedBytes += entry.emittedBytes.load(std::memory_order_relaxed);
+        site.filtered += entry.filtered.load(std::memory_order_relaxed);
+        site.time += std::chrono::nanoseconds { entry.nanoseconds.load(std::memory_order_relaxed) };
+    });
+}
+
+//! Owner of the call site table of a thread. The table is created on the first profiled message.
+class ThreadCallSites
+{
+public:
+    ~ThreadCallSites()
+    {
+        if (m_table) {
+            auto && registry = profileRegistry();
+            std::lock_guard<std::mutex> lock { registry.mutex };
+            mergeCallSites(*m_table, registry.retired);
+            registry.tables.erase(std::find(registry.tables.begin(), registry.tables.end(), m_table.get()));
+        }
+    }
+
+    CallSiteTable & table()
+    {
+        if (!m_table) {
+            m_table = std::make_unique<CallSiteTable>();
+            auto && registry = profileRegistry();
+            std::lock_guard<std::mutex> lock { registry.mutex };
+            registry.tables.push_back(m_table.get());
+        }
+        return *m_table;
+    }
+
+private:
+    std::unique_ptr<CallSiteTable> m_table;
+};
+
+void writeProfileReportAtExit()
+{
+    SimpleLogger::writeProfileReport(std::cerr);
+}
+
+#if defined(SIMPLE_LOGGER_HAVE_SSE2) || defined(SIMPLE_LOGGER_HAVE_AVX2)
+unsigned countTrailingZeros(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+//! \return True if c ends a line, or with Controls if c is a control character other than tab.
+template<bool Controls>
+bool isLineBreak(char c)
+{
+    if constexpr (Controls) {
+        return static_cast<unsigned char>(c) < 0x20 && c != '\t';
+    } else {
+        return c == '\n';
+    }
+}
+
+//! Vectorized search for the first character for which isLineBreak<Controls>() is true.
+//! \return Its position or std::string_view::npos.
+template<bool Controls>
+size_t findLineBreak(std::string_view text)
+{
+    const auto data = text.data();
+    const auto size = text.size();
+    size_t i = 0;
+#ifdef SIMPLE_LOGGER_HAVE_AVX2
+    const auto newline32 = _mm256_set1_epi8('\n');
+    const auto tab32 = _mm256_set1_epi8('\t');
+    const auto lastControl32 = _mm256_set1_epi8(0x1f);
+    for (; i + 32 <= size; i += 32) {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        uint32_t mask = 0;
+        if constexpr (Controls) {
+            // max(c, 0x1f) == 0x1f for unsigned c <= 0x1f
+            const auto controls = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, lastControl32), lastControl32);
+            mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, tab32), controls)));
+        } else {
+            mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline32)));
+        }
+        if (mask) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+#endif
+#ifdef SIMPLE_LOGGER_HAVE_SSE2
+    const auto newline16 = _mm_set1_epi8('\n');
+    const auto tab16 = _mm_set1_epi8('\t');
+    const auto lastControl16 = _mm_set1_epi8(0x1f);
+    for (; i + 16 <= size; i += 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        uint32_t mask = 0;
+        if constexpr (Controls) {
+            const auto controls = _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControl16), lastControl16);
+            mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(_mm_cmpeq_epi8(chunk, tab16), controls)));
+        } else {
+            mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline16)));
+        }
+        if (mask) {
+            return i + countTrailingZeros(mask);
+        }
+    }
+#endif
+    for (; i < size; i++) {
+        if (isLineBreak<Controls>(data[i])) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+//! Append c as an escape sequence: \n, \r or \xHH.
+void appendEscaped(std::string & out, char c)
+{
+    static constexpr char digits[] = "0123456789abcdef";
+    switch (c) {
+    case '\n':
+        out.append("\\n");
+        break;
+    case '\r':
+        out.append("\\r");
+        break;
+    default: {
+        const auto value = static_cast<unsigned char>(c);
+        const std::array<char, 4> escaped = { '\\', 'x', digits[value >> 4], digits[value & 0xf] };
+        out.append(escaped.data(), escaped.size());
+    } break;
+    }
+}
+
+void appendNumber(std::string & out, int64_t value)
+{
+    std::array<char, 32> buffer;
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out.append(buffer.data(), result.ptr);
+}
+
+//! Append value / 1000 with three decimals, e.g. nanoseconds as microseconds.
+void appendThousandths(std::string & out, int64_t value)
+{
+    if (value < 0) {
+        out.push_back('-');
+        value = -value;
+    }
+    appendNumber(out, value / 1000);
+    const auto fraction = value % 1000;
+    const std::array<char, 4> digits = { '.', static_cast<char>('0' + fraction / 100), static_cast<char>('0' + fraction / 10 % 10), static_cast<char>('0' + fraction % 10) };
+    out.append(digits.data(), digits.size());
+}
+
+//! Append text as a quoted JSON string.
+void appendJsonString(std::string & out, std::string_view text)
+{
+    static constexpr char digits[] = "0123456789abcdef";
+    out.push_back('"');
+    for (auto && c : text) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            const std::array<char, 6> escaped = { '\\', 'u', '0', '0', digits[c >> 4], digits[c & 0xf] };
+            out.append(escaped.data(), escaped.size());
+        } else {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+int64_t processId()
+{
+#ifdef _WIN32
+    return _getpid();
+#else
+    return ::getpid();
+#endif
+}
+
+void appendDateTime(std::string & out, std::chrono::system_clock::time_point now, const char * format)
+{
+    const auto rawTime = std::chrono::system_clock::to_time_t(now);
+    std::tm localTime {};
+#ifdef _WIN32
+    localtime_s(&localTime, &rawTime);
+#else
+    localtime_r(&rawTime, &localTime);
+#endif
+    std::array<char, 256> buffer;
+    out.append(buffer.data(), std::strftime(buffer.data(), buffer.size(), format, &localTime));
+}
+
+void appendTimestamp(std::string & out, SimpleLogger::TimestampMode timestampMode, const std::string & customFormat, std::chrono::system_clock::time_point now)
+{
+    using std::chrono::duration_cast;
+
+    switch (timestampMode) {
+    case SimpleLogger::TimestampMode::None:
+        break;
+    case SimpleLogger::TimestampMode::DateTime:
+        appendDateTime(out, now, "%a %b %e %H:%M:%S %Y");
+        break;
+    case SimpleLogger::TimestampMode::ISODateTime:
+        appendDateTime(out, now, "%Y-%m-%dT%H:%M:%S");
+        break;
+    case SimpleLogger::TimestampMode::ISODateTimeMilliseconds: {
+        appendDateTime(out, now, "%Y-%m-%dT%H:%M:%S");
+        const auto milliseconds = duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+        const std::array<char, 4> fraction = { '.', static_cast<char>('0' + milliseconds / 100), static_cast<char>('0' + milliseconds / 10 % 10), static_cast<char>('0' + milliseconds % 10) };
+        out.append(fraction.data(), fraction.size());
+    } break;
+    case SimpleLogger::TimestampMode::EpochSeconds:
+        appendNumber(out, duration_cast<std::chrono::seconds>(now.time_since_epoch()).count());
+        break;
+    case SimpleLogger::TimestampMode::EpochMilliseconds:
+        appendNumber(out, duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count());
+        break;
+    case SimpleLogger::TimestampMode::EpochMicroseconds:
+        appendNumber(out, duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count());
+        break;
+    case SimpleLogger::TimestampMode::Custom:
+        appendDateTime(out, now, customFormat.c_str());
+        break;
+    }
+}
+
+//! A step of a compiled output pattern.
+struct LayoutOp
+{
+    enum class Type
+    {
+        Literal,
+        Timestamp,
+        LegacyTimestamp,
+        LevelSymbol,
+        Tag,
+        LegacyTag,
+        ThreadId,
+        ThreadName,
+        File,
+        Line,
+        Function,
+        Message
+    };
+
+    Type type;
+
+    //! Literal text or a custom timestamp format.
+    std::string text;
+
+    //! Timestamp mode, or the mode of the context if not set.
+    std::optional<SimpleLogger::TimestampMode> timestampMode;
+};
+
+using Layout = std::vector<LayoutOp>;
+
+//! Layout used when no pattern is set: [timestamp + separator][symbol][ tag:] message
+Layout legacyLayout()
+{
+    return {
+        { LayoutOp::Type::LegacyTimestamp, {}, {} },
+        { LayoutOp::Type::LevelSymbol, {}, {} },
+        { LayoutOp::Type::LegacyTag, {}, {} },
+        { LayoutOp::Type::Literal, " ", {} },
+        { LayoutOp::Type::Message, {}, {} }
+    };
+}
+
+LayoutOp compileTimestampOp(std::string_view spec)
+{
+    static const std::map<std::string_view, SimpleLogger::TimestampMode> modes = {
+        { "DATETIME", SimpleLogger::TimestampMode::DateTime },
+        { "ISO", SimpleLogger::TimestampMode::ISODateTime },
+        { "ISO_MS", SimpleLogger::TimestampMode::ISODateTimeMilliseconds },
+        { "EPOCH_S", SimpleLogger::TimestampMode::EpochSeconds },
+        { "EPOCH_MS", SimpleLogger::TimestampMode::EpochMilliseconds },
+        { "EPOCH_US", SimpleLogger::TimestampMode::EpochMicroseconds }
+    };
+
+    if (const auto mode = modes.find(spec); mode != modes.end()) {
+        return { LayoutOp::Type::Timestamp, {}, mode->second };
+    }
+    return { LayoutOp::Type::Timestamp, std::string { spec }, SimpleLogger::TimestampMode::Custom };
+}
+
+Layout compilePattern(std::string_view pattern)
+{
+    if (pattern.empty()) {
+        return legacyLayout();
+    }
+
+    Layout layout;
+    const auto appendLiteral = [&layout](std::string_view text) {
+        if (layout.empty() || layout.back().type != LayoutOp::Type::Literal) {
+            layout.push_back({ LayoutOp::Type::Literal, {}, {} });
+        }
+        layout.back().text.append(text);
+    };
+
+    for (size_t i = 0; i < pattern.size(); i++) {
+        if (pattern[i] != '%' || i + 1 == pattern.size()) {
+            appendLiteral(pattern.substr(i, 1));
+            continue;
+        }
+
+        switch (pattern[++i]) {
+        case 'd':
+            if (i + 1 < pattern.size() && pattern[i + 1] == '{') {
+                if (const auto end = pattern.find('}', i + 2); end != std::string_view::npos) {
+                    layout.push_back(compileTimestampOp(pattern.substr(i + 2, end - i - 2)));
+                    i = end;
+                    break;
+                }
+            }
+            layout.push_back({ LayoutOp::Type::Timestamp, {}, {} });
+            break;
+        case 'l':
+            layout.push_back({ LayoutOp::Type::LevelSymbol, {}, {} });
+            break;
+        case 'T':
+            layout.push_back({ LayoutOp::Type::Tag, {}, {} });
+            break;
+        case 't':
+            layout.push_back({ LayoutOp::Type::ThreadId, {}, {} });
+            break;
+        case 'N':
+            layout.push_back({ LayoutOp::Type::ThreadName, {}, {} });
+            break;
+        case 'F':
+            layout.push_back({ LayoutOp::Type::File, {}, {} });
+            break;
+        case 'L':
+            layout.push_back({ LayoutOp::Type::Line, {}, {} });
+            break;
+        case 'M':
+            layout.push_back({ LayoutOp::Type::Function, {}, {} });
+            break;
+        case 'm':
+            layout.push_back({ LayoutOp::Type::Message, {}, {} });
+            break;
+        case 'n':
+            appendLiteral("\n");
+            break;
+        default:
+            // %% and unknown conversions are output as is
+            appendLiteral(pattern.substr(pattern[i] == '%' ? i : i - 1, pattern[i] == '%' ? 1 : 2));
+            break;
+        }
+    }
+
+    return layout;
+}
+
+//! Writes to stdout/stderr file descriptors directly, bypassing iostreams.
+class ConsoleSink : public SimpleLogger::Sink
+{
+public:
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            const auto fd = record.level >= SimpleLogger::Level::Warning ? StderrFd : StdoutFd;
+            if (fd != m_fd) {
+                // Keep the order of messages across stdout and stderr
+                flush();
+                m_fd = fd;
+            }
+            m_buffer.append(record.text);
+            m_buffer.push_back('\n');
+            if (m_buffer.size() >= MaxBufferSize) {
+                flush();
+            }
+        }
+    }
+
+    void flush() override
+    {
+        const char * data = m_buffer.data();
+        auto remaining = m_buffer.size();
+        while (remaining) {
+#ifdef _WIN32
+            const auto written = ::_write(m_fd, data, static_cast<unsigned int>(remaining));
+#else
+            const auto written = ::write(m_fd, data, remaining);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        m_buffer.clear();
+    }
+
+private:
+    static constexpr int StdoutFd = 1;
+
+    static constexpr int StderrFd = 2;
+
+    static constexpr size_t MaxBufferSize = 64 * 1024;
+
+    int m_fd = StdoutFd;
+
+    std::string m_buffer;
+};
+
+#ifdef SIMPLE_LOGGER_HAVE_ZLIB
+
+//! Writes each flushed batch as an independent gzip member, so that the file can be
+//! decompressed with standard tools and a crash loses at most the batch being written.
+//! Compresses on a worker thread. Each member collects the input until it reaches MemberSize or
+//! the oldest record in it has waited for the flush interval, so that small batches don't each pay
+//! for the overhead of a member.
+class CompressedFileSink : public SimpleLogger::Sink
+{
+public:
+    CompressedFileSink(const std::string & filename, bool append, int compressionLevel, std::chrono::milliseconds flushInterval)
+      : m_fileStream { filename, std::ofstream::out | std::ofstream::binary | (append ? std::ofstream::app : std::ofstream::trunc) }
+      , m_flushInterval { flushInterval }
+    {
+        if (!m_fileStream.is_open()) {
+            throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for write.\n");
+        }
+
+        // 15 + 16 = maximum window size with a gzip header
+        if (deflateInit2(&m_stream, compressionLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("ERROR!!: Couldn't initialize compression for '" + filename + "'.\n");
+        }
+
+        m_thread = std::thread { &CompressedFileSink::run, this };
+    }
+
+    ~CompressedFileSink() override
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+        m_inputAvailable.notify_one();
+        m_thread.join();
+        deflateEnd(&m_stream);
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (m_input.empty()) {
+            // Starts the timer of the member
+            m_oldestInput = std::chrono::steady_clock::now();
+            m_inputAvailable.notify_one();
+        }
+        for (auto && record : records) {
+            m_input.append(record.text);
+            m_input.push_back('\n');
+        }
+    }
+
+    void flush() override
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        if (m_input.size() >= MemberSize) {
+            m_inputAvailable.notify_one();
+        }
+    }
+
+private:
+    static constexpr size_t MemberSize = 64 * 1024;
+
+    void run()
+    {
+        std::string input;
+        for (;;) {
+            bool stop = false;
+            {
+                std::unique_lock<std::mutex> lock { m_mutex };
+                const auto ready = [this] {
+                    return m_stop || m_input.size() >= MemberSize || (!m_input.empty() && std::chrono::steady_clock::now() >= m_oldestInput + m_flushInterval);
+                };
+                while (!ready()) {
+                    if (m_input.empty()) {
+                        m_inputAvailable.wait(lock);
+                    } else {
+                        m_inputAvailable.wait_until(lock, m_oldestInput + m_flushInterval);
+                    }
+                }
+                stop = m_stop;
+                std::swap(input, m_input);
+            }
+
+            if (!input.empty()) {
+                writeMember(input);
+                input.clear();
+            }
+            if (stop) {
+                return;
+            }
+        }
+    }
+
+    void writeMember(std::string & input)
+    {
+        m_output.resize(deflateBound(&m_stream, static_cast<uLong>(input.size())));
+        m_stream.next_in = reinterpret_cast<Bytef *>(input.data());
+        m_stream.avail_in = static_cast<uInt>(input.size());
+        m_stream.next_out = reinterpret_cast<Bytef *>(m_output.data());
+        m_stream.avail_out = static_cast<uInt>(m_output.size());
+        deflate(&m_stream, Z_FINISH);
+
+        m_fileStream.write(m_output.data(), static_cast<std::streamsize>(m_output.size() - m_stream.avail_out));
+        m_fileStream.flush();
+
+        deflateReset(&m_stream);
+    }
+
+    std::ofstream m_fileStream;
+
+    std::chrono::milliseconds m_flushInterval;
+
+    z_stream m_stream {};
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_inputAvailable;
+
+    std::string m_input;
+
+    std::chrono::steady_clock::time_point m_oldestInput;
+
+    bool m_stop = false;
+
+    std::string m_output;
+
+    std::thread m_thread;
+};
+
+#endif
+
+//! Binary format of block files. All integers are little-endian.
+//!
+//! Block:       "SLB1" | first time (i64) | last time (i64) | level bitmap (u32) | record count (u32) | payload size (u64) | records
+//! Record:      time (i64) | level (u8) | text size (u32) | text
+//! Index entry: block offset (u64) | block header
+//!
+//! Times are microseconds since the epoch. The index is written to <filename>.idx after each block.
+namespace BlockFile {
+
+constexpr std::array<char, 4> Magic = { 'S', 'L', 'B', '1' };
+
+constexpr size_t HeaderSize = Magic.size() + 8 + 8 + 4 + 4 + 8;
+
+constexpr size_t IndexEntrySize = 8 + HeaderSize;
+
+constexpr size_t MaxPayloadSize = 1024 * 1024;
+
+constexpr size_t RecordHeaderSize = 8 + 1 + 4;
+
+struct Header
+{
+    int64_t firstTime = 0;
+    int64_t lastTime = 0;
+    uint32_t levels = 0;
+    uint32_t recordCount = 0;
+    uint64_t payloadSize = 0;
+};
+
+struct Block
+{
+    uint64_t offset;
+    Header header;
+};
+
+template<typename T>
+void put(std::string & out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xff));
+    }
+}
+
+template<typename T>
+T get(const char *& data)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    data += sizeof(T);
+    return static_cast<T>(value);
+}
+
+void putHeader(std::string & out, const Header & header)
+{
+    out.append(Magic.data(), Magic.size());
+    put(out, header.firstTime);
+    put(out, header.lastTime);
+    put(out, header.levels);
+    put(out, header.recordCount);
+    put(out, header.payloadSize);
+}
+
+bool getHeader(const char * data, Header & header)
+{
+    if (!std::equal(Magic.begin(), Magic.end(), data)) {
+        return false;
+    }
+    data += Magic.size();
+    header.firstTime = get<int64_t>(data);
+    header.lastTime = get<int64_t>(data);
+    header.levels = get<uint32_t>(data);
+    header.recordCount = get<uint32_t>(data);
+    header.payloadSize = get<uint64_t>(data);
+    return true;
+}
+
+int64_t toMicroseconds(std::chrono::system_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMicroseconds(int64_t microseconds)
+{
+    using std::chrono::system_clock;
+    return system_clock::time_point { std::chrono::duration_cast<system_clock::duration>(std::chrono::microseconds { microseconds }) };
+}
+
+std::string indexFileName(const std::string & filename)
+{
+    return filename + ".idx";
+}
+
+//! Read block headers from the data file starting at the given offset, skipping over the payloads.
+void scanBlocks(std::ifstream & file, uint64_t offset, uint64_t fileSize, std::vector<Block> & blocks)
+{
+    std::array<char, HeaderSize> buffer;
+    while (offset + HeaderSize <= fileSize) {
+        file.seekg(static_cast<std::streamoff>(offset));
+        Header header;
+        if (!file.read(buffer.data(), buffer.size()) || !getHeader(buffer.data(), header) || offset + HeaderSize + header.payloadSize > fileSize) {
+            // Truncated by a crash
+            break;
+        }
+        blocks.push_back({ offset, header });
+        offset += HeaderSize + header.payloadSize;
+    }
+    file.clear();
+}
+
+//! Read the index and scan the blocks written after the last indexed one, if any.
+std::vector<Block> readBlocks(const std::string & filename, std::ifstream & file)
+{
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+
+    std::vector<Block> blocks;
+    std::ifstream index { indexFileName(filename), std::ios::binary };
+    std::array<char, IndexEntrySize> buffer;
+    while (index.read(buffer.data(), buffer.size())) {
+        const char * data = buffer.data();
+        Block block;
+        block.offset = get<uint64_t>(data);
+        const auto expectedOffset = blocks.empty() ? 0 : blocks.back().offset + HeaderSize + blocks.back().header.payloadSize;
+        if (block.offset != expectedOffset || !getHeader(data, block.header) || block.offset + HeaderSize + block.header.payloadSize > fileSize) {
+            break;
+        }
+        blocks.push_back(block);
+    }
+
+    scanBlocks(file, blocks.empty() ? 0 : blocks.back().offset + HeaderSize + blocks.back().header.payloadSize, fileSize, blocks);
+    return blocks;
+}
+
+} // namespace BlockFile
+
+//! Writes records in blocks with a header and an index so that they can be queried by time and level.
+//! A flush closes the block once it has reached the block size or has been open for the block interval,
+//! so that small batches don't each get a block and an index entry.
+class BlockFileSink : public SimpleLogger::Sink
+{
+public:
+    BlockFileSink(const std::string & filename, bool append, size_t blockSize, std::chrono::milliseconds blockInterval)
+      : m_blockSize { std::min(blockSize, BlockFile::MaxPayloadSize) }
+      , m_blockInterval { blockInterval }
+    {
+        uint64_t offset = 0;
+        std::vector<BlockFile::Block> blocks;
+        if (append) {
+            if (std::ifstream existing { filename, std::ios::binary }; existing.is_open()) {
+                blocks = BlockFile::readBlocks(filename, existing);
+                if (!blocks.empty()) {
+                    offset = blocks.back().offset + BlockFile::HeaderSize + blocks.back().header.payloadSize;
+                } else if (existing.seekg(0, std::ios::end).tellg() > 0) {
+                    throw std::runtime_error("ERROR!!: '" + filename + "' isn't a block file, refusing to overwrite it.\n");
+                }
+            }
+        }
+
+        // Drop a block truncated by a crash, if any, and rewrite the index to match the data
+        if (offset) {
+            std::filesystem::resize_file(filename, offset);
+        }
+        m_fileStream.open(filename, std::ofstream::out | std::ofstream::binary | (offset ? std::ofstream::app : std::ofstream::trunc));
+        if (!m_fileStream.is_open()) {
+            throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for write.\n");
+        }
+        m_offset = offset;
+
+        m_indexStream.open(BlockFile::indexFileName(filename), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!m_indexStream.is_open()) {
+            throw std::runtime_error("ERROR!!: Couldn't open '" + BlockFile::indexFileName(filename) + "' for write.\n");
+        }
+        for (auto && block : blocks) {
+            writeIndexEntry(block);
+        }
+        m_indexStream.flush();
+    }
+
+    ~BlockFileSink() override
+    {
+        closeBlock();
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            if (m_payload.size() >= BlockFile::MaxPayloadSize) {
+                closeBlock();
+            }
+
+            const auto time = BlockFile::toMicroseconds(record.time);
+            if (!m_header.recordCount) {
+                m_blockStart = std::chrono::steady_clock::now();
+                m_header.firstTime = time;
+                m_header.lastTime = time;
+            }
+            m_header.firstTime = std::min(m_header.firstTime, time);
+            m_header.lastTime = std::max(m_header.lastTime, time);
+            m_header.levels |= 1u << static_cast<unsigned int>(record.level);
+            m_header.recordCount++;
+
+            BlockFile::put(m_payload, time);
+            BlockFile::put(m_payload, static_cast<uint8_t>(record.level));
+            BlockFile::put(m_payload, static_cast<uint32_t>(record.text.size()));
+            m_payload.append(record.text);
+        }
+    }
+
+    void flush() override
+    {
+        if (m_header.recordCount && (m_payload.size() >= m_blockSize || std::chrono::steady_clock::now() - m_blockStart >= m_blockInterval)) {
+            closeBlock();
+        }
+    }
+
+private:
+    void closeBlock()
+    {
+        if (!m_header.recordCount) {
+            return;
+        }
+
+        m_header.payloadSize = m_payload.size();
+        m_buffer.clear();
+        BlockFile::putHeader(m_buffer, m_header);
+        m_buffer.append(m_payload);
+        m_fileStream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        m_fileStream.flush();
+
+        writeIndexEntry({ m_offset, m_header });
+        m_indexStream.flush();
+
+        m_offset += m_buffer.size();
+        m_header = {};
+        m_payload.clear();
+    }
+
+    void writeIndexEntry(const BlockFile::Block & block)
+    {
+        std::string entry;
+        BlockFile::put(entry, block.offset);
+        BlockFile::putHeader(entry, block.header);
+        m_indexStream.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+    }
+
+    size_t m_blockSize;
+
+    std::chrono::milliseconds m_blockInterval;
+
+    std::chrono::steady_clock::time_point m_blockStart;
+
+    std::ofstream m_fileStream;
+
+    std::ofstream m_indexStream;
+
+    uint64_t m_offset = 0;
+
+    BlockFile::Header m_header;
+
+    std::string m_payload;
+
+    std::string m_buffer;
+};
+
+#ifndef _WIN32
+
+/*!
+ * Sends records to a local collector over a Unix domain socket. Stream sockets frame the records
+ * with octet counting (RFC 6587: "LENGTH SP TEXT"), datagram sockets send one record per datagram.
+ * The socket is non-blocking: whatever can't be sent is kept in a bounded spill buffer and sent
+ * after the next records or after reconnecting, which is attempted at most every ReconnectInterval.
+ */
+class UnixSocketSink : public SimpleLogger::Sink
+{
+public:
+    UnixSocketSink(std::string path, SimpleLogger::SocketType type, size_t spillCapacity)
+      : m_type { type }
+      , m_spillCapacity { spillCapacity }
+    {
+        if (path.size() >= sizeof(m_address.sun_path)) {
+            throw std::runtime_error("ERROR!!: Socket path '" + path + "' is too long.\n");
+        }
+        m_address.sun_family = AF_UNIX;
+        std::memcpy(m_address.sun_path, path.c_str(), path.size() + 1);
+        connect();
+    }
+
+    ~UnixSocketSink() override
+    {
+        // Last chance to send the spilled records
+        if (m_socket < 0 && !m_spill.empty()) {
+            connect();
+        }
+        if (m_socket >= 0) {
+            sendSpill();
+            ::close(m_socket);
+        }
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        if (m_socket < 0 && std::chrono::steady_clock::now() >= m_nextConnectTime) {
+            connect();
+        }
+
+        size_t sent = 0;
+        if (m_socket >= 0 && m_spill.empty()) {
+            // Nothing queued, send directly from the records
+            m_frames.clear();
+            m_prefixes.resize(records.size());
+            for (size_t i = 0; i < records.size(); i++) {
+                m_frames.push_back({ prefix(records[i].text, m_prefixes[i]), records[i].text });
+            }
+            std::tie(sent, m_offset) = send(m_frames, 0);
+        }
+
+        for (size_t i = sent; i < records.size(); i++) {
+            std::array<char, MaxPrefixLength> buffer;
+            const auto framePrefix = prefix(records[i].text, buffer);
+            std::string frame;
+            frame.reserve(framePrefix.size() + records[i].text.size());
+            frame.append(framePrefix).append(records[i].text);
+            spill(std::move(frame));
+        }
+
+        if (m_socket >= 0) {
+            sendSpill();
+        }
+        trimSpill();
+    }
+
+    //! Retry the spilled records, reconnecting if needed.
+    void flush() override
+    {
+        if (m_spill.empty()) {
+            return;
+        }
+        if (m_socket < 0 && std::chrono::steady_clock::now() >= m_nextConnectTime) {
+            connect();
+        }
+        if (m_socket >= 0) {
+            sendSpill();
+        }
+    }
+
+private:
+    static constexpr size_t MaxPrefixLength = 24;
+
+    static constexpr size_t MaxFramesPerCall = 64;
+
+    static constexpr auto ReconnectInterval = std::chrono::milliseconds(100);
+
+    struct Frame
+    {
+        std::string_view prefix;
+        std::string_view text;
+
+        size_t size() const
+        {
+            return prefix.size() + text.size();
+        }
+    };
+
+    std::string_view prefix(std::string_view text, std::array<char, MaxPrefixLength> & buffer) const
+    {
+        if (m_type == SimpleLogger::SocketType::Datagram) {
+            return {};
+        }
+        auto end = std::to_chars(buffer.data(), buffer.data() + buffer.size() - 1, text.size()).ptr;
+        *end++ = ' ';
+        return { buffer.data(), static_cast<size_t>(end - buffer.data()) };
+    }
+
+    void connect()
+    {
+        m_nextConnectTime = std::chrono::steady_clock::now() + ReconnectInterval;
+
+        const int socketType = m_type == SimpleLogger::SocketType::Stream ? SOCK_STREAM : SOCK_DGRAM;
+        const int fd = ::socket(AF_UNIX, socketType, 0);
+        if (fd < 0) {
+            return;
+        }
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+        const int enable = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&m_address), sizeof(m_address)) != 0) {
+            ::close(fd);
+            return;
+        }
+
+        m_socket = fd;
+        m_offset = 0;
+        if (m_dropped) {
+            m_spill.push_front(notice());
+            m_spillSize += m_spill.front().size();
+            m_dropped = 0;
+        }
+    }
+
+    void disconnect()
+    {
+        ::close(m_socket);
+        m_socket = -1;
+        // The collector discards a partial frame with the connection, so it's sent again in full
+        m_offset = 0;
+    }
+
+    std::string notice() const
+    {
+        std::string text = "SimpleLogger: " + std::to_string(m_dropped) + " messages dropped";
+        std::array<char, MaxPrefixLength> buffer;
+        return std::string { prefix(text, buffer) } + text;
+    }
+
+    void spill(std::string frame)
+    {
+        m_spillSize += frame.size();
+        m_spill.push_back(std::move(frame));
+    }
+
+    //! Drop the oldest frames that don't fit. A partially sent frame is kept.
+    void trimSpill()
+    {
+        const size_t keep = m_offset ? 1 : 0;
+        while (m_spillSize > m_spillCapacity && m_spill.size() > keep) {
+            auto && frame = m_spill[keep];
+            m_spillSize -= frame.size();
+            m_spill.erase(m_spill.begin() + static_cast<std::ptrdiff_t>(keep));
+            m_dropped++;
+        }
+    }
+
+    void sendSpill()
+    {
+        while (m_socket >= 0 && !m_spill.empty()) {
+            m_frames.clear();
+            for (size_t i = 0; i < m_spill.size() && i < MaxFramesPerCall; i++) {
+                m_frames.push_back({ {}, m_spill[i] });
+            }
+            const auto [sent, offset] = send(m_frames, m_offset);
+            for (size_t i = 0; i < sent; i++) {
+                m_spillSize -= m_spill.front().size();
+                m_spill.pop_front();
+            }
+            m_offset = offset;
+            if (sent < m_frames.size()) {
+                break;
+            }
+        }
+    }
+
+    //! Send frames starting from offset bytes into the first one.
+    //! \return The number of frames sent completely and the bytes sent of the next one.
+    std::pair<size_t, size_t> send(const std::vector<Frame> & frames, size_t offset)
+    {
+        return m_type == SimpleLogger::SocketType::Stream ? sendStream(frames, offset) : std::make_pair(sendDatagrams(frames), size_t { 0 });
+    }
+
+    std::pair<size_t, size_t> sendStream(const std::vector<Frame> & frames, size_t offset)
+    {
+        size_t sent = 0;
+        while (sent < frames.size()) {
+            // sendmsg() instead of writev() for MSG_NOSIGNAL
+            m_iovecs.clear();
+            for (size_t i = sent; i < frames.size() && m_iovecs.size() + 2 <= MaxFramesPerCall * 2; i++) {
+                auto skip = i == sent ? offset : 0;
+                for (auto && part : { frames[i].prefix, frames[i].text }) {
+                    if (skip >= part.size()) {
+                        skip -= part.size();
+                        continue;
+                    }
+                    m_iovecs.push_back({ const_cast<char *>(part.data() + skip), part.size() - skip });
+                    skip = 0;
+                }
+            }
+
+            msghdr message {};
+            message.msg_iov = m_iovecs.data();
+            message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(m_iovecs.size());
+            const auto result = ::sendmsg(m_socket, &message, SendFlags);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    disconnect();
+                }
+                break;
+            }
+
+            auto written = static_cast<size_t>(result);
+            while (sent < frames.size() && offset + written >= frames[sent].size()) {
+                written -= frames[sent].size() - offset;
+                offset = 0;
+                sent++;
+            }
+            offset += written;
+        }
+        return { sent, m_socket >= 0 ? offset : 0 };
+    }
+
+    size_t sendDatagrams(const std::vector<Frame> & frames)
+    {
+        size_t sent = 0;
+        while (sent < frames.size()) {
+            const auto count = std::min(frames.size() - sent, MaxFramesPerCall);
+            m_iovecs.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                m_iovecs[i] = { const_cast<char *>(frames[sent + i].text.data()), frames[sent + i].text.size() };
+            }
+#ifdef __linux__
+            m_messages.assign(count, {});
+            for (size_t i = 0; i < count; i++) {
+                m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+                m_messages[i].msg_hdr.msg_iovlen = 1;
+            }
+            const int result = ::sendmmsg(m_socket, m_messages.data(), static_cast<unsigned int>(count), SendFlags);
+#else
+            msghdr message {};
+            message.msg_iov = m_iovecs.data();
+            message.msg_iovlen = 1;
+            const int result = ::sendmsg(m_socket, &message, SendFlags) < 0 ? -1 : 1;
+#endif
+            if (result > 0) {
+                sent += static_cast<size_t>(result);
+                continue;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EMSGSIZE) {
+                // Would never fit
+                sent++;
+                m_dropped++;
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS) {
+                disconnect();
+            }
+            break;
+        }
+        return sent;
+    }
+
+#ifdef MSG_NOSIGNAL
+    static constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+    static constexpr int SendFlags = 0;
+#endif
+
+    SimpleLogger::SocketType m_type;
+
+    size_t m_spillCapacity;
+
+    sockaddr_un m_address {};
+
+    int m_socket = -1;
+
+    std::chrono::steady_clock::time_point m_nextConnectTime;
+
+    // Complete frames not sent yet. m_offset bytes of the first one have been sent.
+    std::deque<std::string> m_spill;
+
+    size_t m_spillSize = 0;
+
+    size_t m_offset = 0;
+
+    size_t m_dropped = 0;
+
+    std::vector<Frame> m_frames;
+
+    std::vector<std::array<char, MaxPrefixLength>> m_prefixes;
+
+    std::vector<iovec> m_iovecs;
+
+#ifdef __linux__
+    std::vector<mmsghdr> m_messages;
+#endif
+};
+
+#endif // _WIN32
+
+#ifndef _WIN32
+
+/*!
+ * Multi-producer, single-consumer ring of records in POSIX shared memory. Producers of any process
+ * reserve space by advancing the head with a CAS, write the record and publish it by storing its
+ * size last. The consumer reads committed records in reservation order, zeroes them and advances
+ * the tail. A record that doesn't fit before the end of the ring is preceded by a padding record.
+ */
+class SharedMemoryRing
+{
+public:
+    //! Create the shared memory object. Throws if it exists or cannot be created.
+    static std::unique_ptr<SharedMemoryRing> create(const std::string & name, size_t capacity)
+    {
+        // Power of two so that offsets are masked
+        size_t dataSize = 4096;
+        while (dataSize < capacity) {
+            dataSize *= 2;
+        }
+
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("ERROR!!: Couldn't create shared memory '" + name + "'.\n");
+        }
+        const size_t size = HeaderSize + dataSize;
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error("ERROR!!: Couldn't resize shared memory '" + name + "'.\n");
+        }
+        auto ring = map(fd, size, name);
+        // The object is zero filled
+        ring->header().capacity = dataSize;
+        ring->header().magic.store(Magic, std::memory_order_release);
+        return ring;
+    }
+
+    //! Open a shared memory object created with create(). Throws on error.
+    static std::unique_ptr<SharedMemoryRing> open(const std::string & name)
+    {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            throw std::runtime_error("ERROR!!: Couldn't open shared memory '" + name + "'.\n");
+        }
+        struct stat status;
+        if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) <= HeaderSize) {
+            ::close(fd);
+            throw std::runtime_error("ERROR!!: Invalid shared memory '" + name + "'.\n");
+        }
+        auto ring = map(fd, static_cast<size_t>(status.st_size), name);
+        if (ring->header().magic.load(std::memory_order_acquire) != Magic || ring->header().capacity + HeaderSize != ring->m_size) {
+            throw std::runtime_error("ERROR!!: Invalid shared memory '" + name + "'.\n");
+        }
+        return ring;
+    }
+
+    ~SharedMemoryRing()
+    {
+        ::munmap(m_memory, m_size);
+    }
+
+    //! Add a record. Messages longer than an eighth of the ring are truncated.
+    //! \return False if the ring is full and block is false.
+    bool push(const SimpleLogger::Record & record, bool block)
+    {
+        auto && header = this->header();
+        const auto capacity = header.capacity;
+        const auto text = record.text.substr(0, capacity / 8 - sizeof(RecordHeader));
+        const auto size = align(sizeof(RecordHeader) + text.size());
+
+        auto head = header.head.load(std::memory_order_relaxed);
+        uint64_t padding = 0;
+        for (;;) {
+            const auto offset = head & (capacity - 1);
+            padding = offset + size > capacity ? capacity - offset : 0;
+            if (head + padding + size - header.tail.load(std::memory_order_acquire) > capacity) {
+                if (!block) {
+                    header.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::yield();
+                head = header.head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (header.head.compare_exchange_weak(head, head + padding + size, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        if (padding) {
+            sizeField(head).store(static_cast<uint32_t>(padding) | PaddingFlag, std::memory_order_release);
+            head += padding;
+        }
+
+        auto entry = reinterpret_cast<RecordHeader *>(data(head));
+        entry->textSize = static_cast<uint32_t>(text.size());
+        entry->level = static_cast<uint32_t>(record.level);
+        entry->time = std::chrono::duration_cast<std::chrono::microseconds>(record.time.time_since_epoch()).count();
+        std::memcpy(entry + 1, text.data(), text.size());
+        sizeField(head).store(static_cast<uint32_t>(size), std::memory_order_release);
+        return true;
+    }
+
+    //! Consume the committed records.
+    //! \param callback Called with the records, or not at all if there are none.
+    //! \return The number of records consumed.
+    size_t drain(const std::function<void(const std::vector<SimpleLogger::Record> &)> & callback)
+    {
+        auto && header = this->header();
+        const auto tail = header.tail.load(std::memory_order_relaxed);
+        const auto head = header.head.load(std::memory_order_acquire);
+        auto position = tail;
+
+        m_text.clear();
+        m_records.clear();
+        m_offsets.clear();
+        // A full ring wraps onto the first record, which hasn't been zeroed yet
+        while (position < head) {
+            const auto size = sizeField(position).load(std::memory_order_acquire);
+            if (!size) {
+                break;
+            }
+            if (!(size & PaddingFlag)) {
+                auto entry = reinterpret_cast<const RecordHeader *>(data(position));
+                m_offsets.push_back(m_text.size());
+                m_text.append(reinterpret_cast<const char *>(entry + 1), entry->textSize);
+                m_records.push_back({ static_cast<SimpleLogger::Level>(entry->level), {}, std::chrono::system_clock::time_point { std::chrono::microseconds { entry->time } } });
+            }
+            position += size & ~PaddingFlag;
+        }
+
+        // Producers may only reuse zeroed memory
+        for (auto zeroed = tail; zeroed < position;) {
+            const auto offset = zeroed & (header.capacity - 1);
+            const auto length = std::min<uint64_t>(position - zeroed, header.capacity - offset);
+            std::memset(data(zeroed), 0, length);
+            zeroed += length;
+        }
+        header.tail.store(position, std::memory_order_release);
+
+        m_offsets.push_back(m_text.size());
+        for (size_t i = 0; i < m_records.size(); i++) {
+            m_records[i].text = std::string_view { m_text }.substr(m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+        }
+
+        if (const auto dropped = header.dropped.exchange(0, std::memory_order_relaxed)) {
+            m_dropNotice = "SimpleLogger: " + std::to_string(dropped) + " messages dropped";
+            m_records.insert(m_records.begin(), { SimpleLogger::Level::Warning, m_dropNotice, std::chrono::system_clock::now() });
+        }
+        if (!m_records.empty()) {
+            callback(m_records);
+        }
+        return m_records.size();
+    }
+
+private:
+    static constexpr uint64_t Magic = 0x53494d504c45524eULL;
+
+    static constexpr size_t HeaderSize = 256;
+
+    static constexpr uint32_t PaddingFlag = 0x80000000u;
+
+    struct Header
+    {
+        std::atomic<uint64_t> magic;
+        uint64_t capacity;
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<uint64_t> dropped;
+    };
+
+    static_assert(sizeof(Header) <= HeaderSize);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, "Atomics in shared memory must be lock-free");
+
+    //! Follows the size field. The text follows the header.
+    struct RecordHeader
+    {
+        uint32_t size;
+        uint32_t textSize;
+        int64_t time;
+        uint32_t level;
+        uint32_t reserved;
+    };
+
+    SharedMemoryRing(void * memory, size_t size)
+      : m_memory { memory }
+      , m_size { size }
+    {
+    }
+
+    static std::unique_ptr<SharedMemoryRing> map(int fd, size_t size, const std::string & name)
+    {
+        void * memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("ERROR!!: Couldn't map shared memory '" + name + "'.\n");
+        }
+        return std::unique_ptr<SharedMemoryRing> { new SharedMemoryRing { memory, size } };
+    }
+
+    static uint64_t align(uint64_t size)
+    {
+        return (size + 7) & ~uint64_t { 7 };
+    }
+
+    Header & header() const
+    {
+        return *static_cast<Header *>(m_memory);
+    }
+
+    char * data(uint64_t position) const
+    {
+        return static_cast<char *>(m_memory) + HeaderSize + (position & (header().capacity - 1));
+    }
+
+    std::atomic<uint32_t> & sizeField(uint64_t position) const
+    {
+        return *reinterpret_cast<std::atomic<uint32_t> *>(data(position));
+    }
+
+    void * m_memory;
+
+    size_t m_size;
+
+    // Used by the consumer
+    std::string m_text;
+    std::vector<size_t> m_offsets;
+    std::vector<SimpleLogger::Record> m_records;
+    std::string m_dropNotice;
+};
+
+//! Writes records into a shared memory ring drained by a collector of another process.
+class SharedMemorySink : public SimpleLogger::Sink
+{
+public:
+    SharedMemorySink(const std::string & name, SimpleLogger::SinkOptions::Overflow overflow)
+      : m_ring { SharedMemoryRing::open(name) }
+      , m_block { overflow == SimpleLogger::SinkOptions::Overflow::Block }
+    {
+    }
+
+    void write(const std::vector<SimpleLogger::Record> & records) override
+    {
+        for (auto && record : records) {
+            m_ring->push(record, m_block);
+        }
+    }
+
+private:
+    std::unique_ptr<SharedMemoryRing> m_ring;
+
+    bool m_block;
+};
+
+#endif // _WIN32
+
+//! Records copied once for all the asynchronous sinks they are written to. The sinks keep a
+//! reference until they have written the records.
+struct SharedRecords
+{
+    void assign(const std::vector<SimpleLogger::Record> & source)
+    {
+        size_t size = 0;
+        for (auto && record : source) {
+            size += record.text.size();
+        }
+        text.clear();
+        text.reserve(size); // The views stay valid
+        records.clear();
+        for (auto && record : source) {
+            records.push_back({ record.level, { text.data() + text.size(), record.text.size() }, record.time });
+            text.append(record.text);
+        }
+    }
+
+    std::string text;
+
+    std::vector<SimpleLogger::Record> records;
+};
+
+//! Runs the writes of a sink. Errors aren't propagated, so that a failing sink can't break the
+//! other sinks or throw from a log statement. A failure is reported to std::cerr once until the
+//! sink succeeds again.
+class SinkErrorReporter
+{
+public:
+    template<typename Function>
+    void run(Function && function)
+    {
+        try {
+            function();
+            m_failing = false;
+        } catch (const std::exception & e) {
+            report(e.what());
+        } catch (...) {
+            report("Unknown error");
+        }
+    }
+
+private:
+    void report(const char * what)
+    {
+        if (!m_failing) {
+            m_failing = true;
+            std::cerr << "ERROR!!: Sink failed: " << what << std::endl;
+        }
+    }
+
+    bool m_failing = false;
+};
+
+//! Writes records to a sink from a worker thread so that a slow sink doesn't stall the others.
+class AsyncSinkWorker
+{
+public:
+    AsyncSinkWorker(SimpleLogger::SinkPtr sink, const SimpleLogger::SinkOptions & options)
+      : m_sink { std::move(sink) }
+      , m_capacity { std::max<size_t>(options.queueCapacity, 1) }
+      , m_overflow { options.overflow }
+      , m_thread { &AsyncSinkWorker::run, this }
+    {
+    }
+
+    ~AsyncSinkWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+        m_workAvailable.notify_one();
+        m_thread.join();
+    }
+
+    //! \param records Records referring to the text of owner.
+    //! \param owner Kept until the records have been written.
+    void push(const std::vector<SimpleLogger::Record> & records, std::shared_ptr<const SharedRecords> owner)
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_owners.push_back(owner);
+        for (auto && record : records) {
+            if (m_queue.size() >= m_capacity) {
+                if (m_overflow == SimpleLogger::SinkOptions::Overflow::Drop) {
+                    m_dropped++;
+                    continue;
+                }
+                m_workAvailable.notify_one();
+                m_spaceAvailable.wait(lock, [this] { return m_queue.size() < m_capacity; });
+
+                // The worker has released the owners of the records it took, the rest of the batch
+                // still refers to the owner
+                m_owners.push_back(owner);
+            }
+            m_queue.push_back(record);
+        }
+        lock.unlock();
+        m_workAvailable.notify_one();
+    }
+
+    //! Flush the sink on the worker thread.
+    void requestFlush()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_flushRequested = true;
+        }
+        m_workAvailable.notify_one();
+    }
+
+    //! Call callback on the worker thread once everything pushed so far has been written.
+    void onWritten(std::function<void()> callback)
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_callbacks.push_back(std::move(callback));
+        }
+        m_workAvailable.notify_one();
+    }
+
+private:
+    void run()
+    {
+        std::vector<SimpleLogger::Record> queue;
+        std::vector<std::shared_ptr<const SharedRecords>> owners;
+        std::vector<SimpleLogger::Record> records;
+        std::vector<std::function<void()>> callbacks;
+        for (;;) {
+            size_t dropped = 0;
+            bool flushRequested = false;
+            {
+                std::unique_lock<std::mutex> lock { m_mutex };
+                m_workAvailable.wait(lock, [this] { return m_stop || !m_queue.empty() || !m_callbacks.empty() || m_flushRequested; });
+                if (m_queue.empty() && m_callbacks.empty() && !m_flushRequested) {
+                    return;
+                }
+                std::swap(flushRequested, m_flushRequested);
+                std::swap(queue, m_queue);
+                std::swap(owners, m_owners);
+                std::swap(dropped, m_dropped);
+                std::swap(callbacks, m_callbacks);
+            }
+            m_spaceAvailable.notify_all();
+
+            std::string droppedMessage;
+            records.clear();
+            if (dropped) {
+                droppedMessage = "SimpleLogger: " + std::to_string(dropped) + " messages dropped";
+                records.push_back({ SimpleLogger::Level::Warning, droppedMessage, std::chrono::system_clock::now() });
+            }
+            records.insert(records.end(), queue.begin(), queue.end());
+
+            if (!records.empty()) {
+                m_errorReporter.run([&] {
+                    m_sink->write(records);
+                    m_sink->flush();
+                });
+            } else if (flushRequested) {
+                m_errorReporter.run([&] {
+                    m_sink->flush();
+                });
+            }
+
+            for (auto && callback : callbacks) {
+                callback();
+            }
+
+            queue.clear();
+            owners.clear();
+            callbacks.clear();
+        }
+    }
+
+    SimpleLogger::SinkPtr m_sink;
+
+    SinkErrorReporter m_errorReporter;
+
+    size_t m_capacity;
+
+    SimpleLogger::SinkOptions::Overflow m_overflow;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_workAvailable;
+
+    std::condition_variable m_spaceAvailable;
+
+    std::vector<SimpleLogger::Record> m_queue;
+
+    std::vector<std::shared_ptr<const SharedRecords>> m_owners;
+
+    std::vector<std::function<void()>> m_callbacks;
+
+    size_t m_dropped = 0;
+
+    bool m_flushRequested = false;
+
+    bool m_stop = false;
+
+    std::thread m_thread;
+};
+
+//! A sink registered to a context.
+class SinkSlot
+{
+public:
+    SinkSlot(SimpleLogger::SinkPtr sink, const SimpleLogger::SinkOptions & options)
+      : m_sink { std::move(sink) }
+      , m_options { options }
+      , m_worker { options.async ? std::make_unique<AsyncSinkWorker>(m_sink, options) : nullptr }
+    {
+    }
+
+    const SimpleLogger::SinkPtr & sink() const
+    {
+        return m_sink;
+    }
+
+    bool isAsync() const
+    {
+        return m_worker != nullptr;
+    }
+
+    //! Write to a synchronous slot.
+    void write(const std::vector<SimpleLogger::Record> & records)
+    {
+        if (const auto & filtered = filter(records); !filtered.empty()) {
+            m_errorReporter.run([&] {
+                m_sink->write(filtered);
+                m_sink->flush();
+            });
+        }
+    }
+
+    //! Queue to an asynchronous slot.
+    void write(const std::shared_ptr<const SharedRecords> & shared)
+    {
+        if (const auto & filtered = filter(shared->records); !filtered.empty()) {
+            m_worker->push(filtered, shared);
+        }
+    }
+
+    //! Flush the sink, e.g. to retry output it has buffered, without new records.
+    void flush()
+    {
+        if (m_worker) {
+            m_worker->requestFlush();
+        } else {
+            m_errorReporter.run([this] {
+                m_sink->flush();
+            });
+        }
+    }
+
+    //! Call callback once everything written to the slot so far has reached the sink.
+    void onWritten(std::function<void()> callback)
+    {
+        if (m_worker) {
+            m_worker->onWritten(std::move(callback));
+        } else {
+            callback();
+        }
+    }
+
+private:
+    const std::vector<SimpleLogger::Record> & filter(const std::vector<SimpleLogger::Record> & records)
+    {
+        if (std::all_of(records.begin(), records.end(), [this](auto && record) { return record.level >= m_options.level; })) {
+            return records;
+        }
+
+        m_filtered.clear();
+        std::copy_if(records.begin(), records.end(), std::back_inserter(m_filtered), [this](auto && record) { return record.level >= m_options.level; });
+        return m_filtered;
+    }
+
+    SimpleLogger::SinkPtr m_sink;
+
+    SimpleLogger::SinkOptions m_options;
+
+    SinkErrorReporter m_errorReporter;
+
+    std::unique_ptr<AsyncSinkWorker> m_worker;
+
+    std::vector<SimpleLogger::Record> m_filtered;
+};
+
+//! Worker threads that run the parts of a job together with the calling thread.
+class RenderPool
+{
+public:
+    explicit RenderPool(size_t workers)
+    {
+        for (size_t i = 0; i < workers; i++) {
+            m_threads.emplace_back(&RenderPool::runWorker, this);
+        }
+    }
+
+    ~RenderPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
+        }
+        m_workAvailable.notify_all();
+        for (auto && thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    //! Call job(index) for each index in [0, count) and wait until all calls have returned.
+    //! Rethrows the first exception thrown by the job.
+    template<typename Job>
+    void run(size_t count, Job & job)
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        m_job = &job;
+        m_invoke = [](void * job, size_t index) {
+            (*static_cast<Job *>(job))(index);
+        };
+        m_count = count;
+        m_next = 0;
+        m_done = 0;
+        m_error = nullptr;
+        m_workAvailable.notify_all();
+
+        work(lock);
+        m_jobDone.wait(lock, [this] { return m_done == m_count; });
+        m_job = nullptr;
+        if (m_error) {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+private:
+    //! Claim parts of the current job until none are left.
+    void work(std::unique_lock<std::mutex> & lock)
+    {
+        while (m_job && m_next < m_count) {
+            const auto index = m_next++;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                m_invoke(m_job, index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_error) {
+                m_error = error;
+            }
+            if (++m_done == m_count) {
+                m_jobDone.notify_all();
+            }
+        }
+    }
+
+    void runWorker()
+    {
+        std::unique_lock<std::mutex> lock { m_mutex };
+        for (;;) {
+            m_workAvailable.wait(lock, [this] { return m_stop || (m_job && m_next < m_count); });
+            if (m_stop) {
+                return;
+            }
+            work(lock);
+        }
+    }
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_workAvailable;
+
+    std::condition_variable m_jobDone;
+
+    // The current job. Not stored as std::function, so that running it doesn't allocate.
+    void * m_job = nullptr;
+    void (*m_invoke)(void *, size_t) = nullptr;
+
+    size_t m_count = 0;
+
+    size_t m_next = 0;
+
+    size_t m_done = 0;
+
+    std::exception_ptr m_error;
+
+    bool m_stop = false;
+
+    std::vector<std::thread> m_threads;
+};
+
+//! Header of a message in the batch queue. Followed by the tag and the message text.
+struct BatchEntry
+{
+    uint64_t ticks;
+    uint64_t threadId;
+    const std::string * threadName;
+    SimpleLogger::SourceLocation location;
+    SimpleLogger::Level level;
+    uint32_t tagSize;
+    uint32_t messageSize;
+
+    std::string_view tag() const
+    {
+        return { reinterpret_cast<const char *>(this + 1), tagSize };
+    }
+
+    std::string_view message() const
+    {
+        return { reinterpret_cast<const char *>(this + 1) + tagSize, messageSize };
+    }
+};
+
+/*!
+ * Batch queue storing the entries back to back in chunks of contiguous memory. reset() keeps
+ * the chunks, so that no memory is allocated once the queue has grown to the size of a batch.
+ */
+class BatchArena
+{
+public:
+    explicit BatchArena(std::pmr::memory_resource * resource)
+      : m_resource { resource ? resource : std::pmr::get_default_resource() }
+      , m_chunks { m_resource }
+    {
+    }
+
+    ~BatchArena()
+    {
+        for (auto && chunk : m_chunks) {
+            m_resource->deallocate(chunk.data, chunk.capacity, alignof(BatchEntry));
+        }
+    }
+
+    void push(const BatchEntry & header, std::string_view tag, std::string_view message)
+    {
+        m_bytes += tag.size() + message.size();
+        const size_t size = align(sizeof(BatchEntry) + tag.size() + message.size());
+        auto data = allocate(size);
+        auto entry = new (data) BatchEntry { header };
+        entry->tagSize = static_cast<uint32_t>(tag.size());
+        entry->messageSize = static_cast<uint32_t>(message.size());
+        // An empty view may have a null data pointer, which memcpy doesn't accept
+        if (!tag.empty()) {
+            std::memcpy(data + sizeof(BatchEntry), tag.data(), tag.size());
+        }
+        if (!message.empty()) {
+            std::memcpy(data + sizeof(BatchEntry) + tag.size(), message.data(), message.size());
+        }
+        m_count++;
+    }
+
+    //! Call function for each entry in the order they were pushed.
+    template<typename Function>
+    void forEach(Function && function) const
+    {
+        for (size_t i = 0; i <= m_current && i < m_chunks.size(); i++) {
+            auto && chunk = m_chunks[i];
+            for (size_t offset = 0; offset < chunk.used;) {
+                auto && entry = *reinterpret_cast<const BatchEntry *>(chunk.data + offset);
+                function(entry);
+                offset += align(sizeof(BatchEntry) + entry.tagSize + entry.messageSize);
+            }
+        }
+    }
+
+    bool empty() const
+    {
+        return !m_count;
+    }
+
+    size_t size() const
+    {
+        return m_count;
+    }
+
+    //! \return Bytes of the tags and the messages.
+    size_t bytes() const
+    {
+        return m_bytes;
+    }
+
+    void reset()
+    {
+        for (auto && chunk : m_chunks) {
+            chunk.used = 0;
+        }
+        m_current = 0;
+        m_count = 0;
+        m_bytes = 0;
+    }
+
+private:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    struct Chunk
+    {
+        char * data;
+        size_t capacity;
+        size_t used;
+    };
+
+    static size_t align(size_t size)
+    {
+        return (size + alignof(BatchEntry) - 1) & ~(alignof(BatchEntry) - 1);
+    }
+
+    char * allocate(size_t size)
+    {
+        while (m_current < m_chunks.size() && m_chunks[m_current].used + size > m_chunks[m_current].capacity) {
+            if (m_chunks[m_current].used) {
+                m_current++;
+                continue;
+            }
+            // An empty chunk retained from an earlier batch is too small for this entry
+            m_resource->deallocate(m_chunks[m_current].data, m_chunks[m_current].capacity, alignof(BatchEntry));
+            m_chunks.erase(m_chunks.begin() + static_cast<std::ptrdiff_t>(m_current));
+        }
+        if (m_current == m_chunks.size()) {
+            const auto capacity = std::max(size, ChunkSize);
+            m_chunks.push_back({ static_cast<char *>(m_resource->allocate(capacity, alignof(BatchEntry))), capacity, 0 });
+        }
+        auto && chunk = m_chunks[m_current];
+        auto data = chunk.data + chunk.used;
+        chunk.used += size;
+        return data;
+    }
+
+    std::pmr::memory_resource * m_resource;
+
+    std::pmr::vector<Chunk> m_chunks;
+
+    size_t m_current = 0;
+
+    size_t m_count = 0;
+
+    size_t m_bytes = 0;
+};
+
+//! Recursive mutex that knows its owner, so that the emergency flush can skip a context locked by
+//! the crashing thread instead of re-entering it.
+class ContextMutex
+{
+public:
+    void lock()
+    {
+        m_mutex.lock();
+        acquired();
+    }
+
+    bool try_lock()
+    {
+        if (!m_mutex.try_lock()) {
+            return false;
+        }
+        acquired();
+        return true;
+    }
+
+    void unlock()
+    {
+        if (!--m_depth) {
+            m_owner.store({}, std::memory_order_relaxed);
+        }
+        m_mutex.unlock();
+    }
+
+    //! \return True if the current thread holds the mutex.
+    bool isHeldByCurrentThread() const
+    {
+        return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+private:
+    void acquired()
+    {
+        if (!m_depth++) {
+            m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        }
+    }
+
+    std::recursive_mutex m_mutex;
+
+    std::atomic<std::thread::id> m_owner {};
+
+    size_t m_depth = 0;
+};
+
+} // namespace
+
+class SimpleLogger::Context::Impl
+{
+public:
+    explicit Impl(const SimpleLogger::Config & config);
+
+    ~Impl();
+
+    void enableEchoMode(bool enable);
+    void enableFastEchoMode(bool enable);
+
+    void setLevelSymbol(SimpleLogger::Level level, std::string symbol);
+    void setCustomTimestampFormat(std::string format);
+    void setTimestampMode(SimpleLogger::TimestampMode timestampMode);
+    void setTimestampSeparator(std::string separator);
+    void setMultiLineMode(SimpleLogger::MultiLineMode multiLineMode);
+    void setClockSource(SimpleLogger::ClockSource clockSource);
+    void setPattern(std::string pattern);
+    void setBatchInterval(std::chrono::milliseconds interval);
+    void setBatchInterval(SimpleLogger::Level level, std::chrono::milliseconds interval);
+    void setAdaptiveBatching(const SimpleLogger::AdaptiveBatching & settings);
+    void setCollapseRepeatedMessages(bool collapse);
+    void setCollapseRepeatedMessages(SimpleLogger::Level level, bool collapse);
+    void setRenderThreads(size_t threads);
+    void setStream(Level level, std::ostream & stream);
+
+    void addSink(SinkPtr sink, const SinkOptions & options);
+    void removeSink(const SinkPtr & sink);
+    void setTraceSink(SinkPtr sink);
+
+    //! Write a span as a trace event, or as a message if there's no trace sink.
+    //! \return Start time of a span, taken under the lock so that it matches the clock source at the end.
+    std::chrono::system_clock::time_point spanStart();
+
+    void endSpan(std::string_view name, std::string_view tag, const SimpleLogger::SourceLocation & location, SimpleLogger::Level level, std::chrono::system_clock::time_point startTime);
+
+    void flush();
+
+    std::future<void> flushAsync();
+
+    //! Flush the batch queue and wait for the asynchronous sinks to write everything queued.
+    //! \return False if the deadline passed first. Throws if a sink throws.
+    bool drain(std::chrono::steady_clock::time_point deadline);
+
+    //! Write messages immediately from now on.
+    void disableBatching();
+
+    void initialize(std::string filename, bool append);
+
+    //! \see SimpleLogger::shutdown()
+    static bool shutdownAll(std::chrono::steady_clock::time_point deadline);
+
+    //! \see SimpleLogger::enableEmergencyFlush()
+    static void enableEmergencyFlush(bool enable);
+
+    ContextMutex & mutex();
+
+    uint64_t clockTicks() const;
+
+    //! A message as captured by the logger.
+    struct MessageView
+    {
+        uint64_t ticks;
+        uint64_t threadId;
+        const std::string * threadName;
+        SimpleLogger::SourceLocation location;
+        SimpleLogger::Level level;
+        std::string_view tag;
+        std::string_view text;
+    };
+
+    void output(const MessageView & message);
+
+private:
+    void render(std::string & out, const MessageView & message, std::chrono::system_clock::time_point time) const;
+
+    //! Append the message text according to the multi-line mode.
+    //! \param lineStart Position of the line in out. What follows it is the prefix of the message.
+    void appendMessage(std::string & out, size_t lineStart, std::string_view text) const;
+
+    //! Lines of a batch rendered by one thread.
+    struct RenderChunk
+    {
+        std::string text;
+        std::vector<size_t> offsets;
+    };
+
+    //! Render the entries [begin, end) of the batch into the chunk and point their records to it.
+    void renderBatch(RenderChunk & chunk, size_t begin, size_t end);
+
+    void writeToSinks(const std::vector<SimpleLogger::Record> & records);
+
+    //! \return Copy of the records for the asynchronous sinks in a block released by them, if any.
+    std::shared_ptr<const SharedRecords> shareRecords(const std::vector<SimpleLogger::Record> & records);
+
+    void runFlusher();
+
+    //! Wake up the flusher thread at the deadline to flush the batch queue.
+    void scheduleFlush(std::chrono::steady_clock::time_point deadline);
+
+    //! Flush the batch queue if its deadline has passed.
+    void flushExpired();
+
+    //! \return Batch interval for a message arriving now, or zero to write it immediately.
+    std::chrono::steady_clock::duration adaptiveInterval(std::chrono::steady_clock::time_point now);
+
+    //! Write the queued trace events to the trace sink.
+    void writeTrace();
+
+    //! Live contexts. Never destroyed, so that it's usable during static destruction.
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<Impl *> contexts;
+    };
+
+    static Registry & registry();
+
+    static void drainAtExit();
+
+    static void emergencyFlush(int signal);
+
+    bool m_echoMode = true;
+
+    static constexpr size_t LevelCount = static_cast<size_t>(SimpleLogger::Level::None);
+
+    // Delivery settings per level
+    std::array<bool, LevelCount> m_collapseRepeated {};
+    std::array<std::chrono::milliseconds, LevelCount> m_batchIntervals {};
+
+    SimpleLogger::TimestampMode m_timestampMode = SimpleLogger::TimestampMode::DateTime;
+
+    std::string m_timestampSeparator = ": ";
+    std::string m_customTimestampFormat;
+
+    Layout m_layout = legacyLayout();
+
+    SimpleLogger::MultiLineMode m_multiLineMode = SimpleLogger::MultiLineMode::Keep;
+
+    std::string m_line;
+
+    std::vector<SimpleLogger::Record> m_records;
+
+    Clock m_clock;
+
+    std::unique_ptr<SinkSlot> m_fileSink;
+
+    std::shared_ptr<StreamSink> m_echoStreamSink = std::make_shared<StreamSink>();
+
+    std::unique_ptr<SinkSlot> m_echoSink = std::make_unique<SinkSlot>(m_echoStreamSink, SimpleLogger::SinkOptions {});
+
+    std::vector<std::unique_ptr<SinkSlot>> m_sinks;
+
+    // Trace events are written in batches, and at least when flushed
+    static constexpr size_t TraceBatchSize = 256;
+    std::unique_ptr<SinkSlot> m_traceSink;
+    std::string m_traceText;
+    std::vector<size_t> m_traceOffsets;
+    std::vector<SimpleLogger::Record> m_traceRecords;
+    std::set<uint64_t> m_tracedThreads;
+    std::string m_spanMessage;
+
+    // Blocks of records shared by the asynchronous sinks, reused once they have been written
+    static constexpr size_t MaxSharedRecords = 16;
+    std::vector<std::shared_ptr<SharedRecords>> m_sharedRecords;
+
+    using SymbolMap = std::map<SimpleLogger::Level, std::string>;
+
+    // Default level symbols
+    SymbolMap m_symbols = {
+        { SimpleLogger::Level::Trace, "T:" },
+        { SimpleLogger::Level::Debug, "D:" },
+        { SimpleLogger::Level::Info, "I:" },
+        { SimpleLogger::Level::Warning, "W:" },
+        { SimpleLogger::Level::Error, "E:" },
+        { SimpleLogger::Level::Fatal, "F:" }
+    };
+
+    ContextMutex m_mutex;
+
+    BatchArena m_batchQueue;
+
+    // Reused by flush()
+    std::vector<const BatchEntry *> m_batchEntries;
+    std::vector<size_t> m_batchCounts;
+    std::vector<SimpleLogger::Record> m_batchRecords;
+    std::vector<RenderChunk> m_renderChunks;
+
+    // Batches of at least this many lines are rendered in parallel
+    static constexpr size_t ParallelRenderThreshold = 2048;
+
+    // Threads rendering a large batch, including the flushing thread. 0 for automatic.
+    size_t m_renderThreads = 0;
+
+    // Created on the first large batch
+    std::unique_ptr<RenderPool> m_renderPool;
+
+    struct CollapseKey
+    {
+        SimpleLogger::Level level;
+        std::string_view tag;
+        std::string_view message;
+
+        bool operator==(const CollapseKey & other) const
+        {
+            return level == other.level && tag == other.tag && message == other.message;
+        }
+    };
+
+    struct CollapseKeyHash
+    {
+        size_t operator()(const CollapseKey & key) const
+        {
+            const std::hash<std::string_view> hash;
+            return hash(key.message) ^ (hash(key.tag) * 31) ^ static_cast<size_t>(key.level);
+        }
+    };
+
+    // Index of the first occurrence in m_batchEntries. The keys refer to the batch queue.
+    std::unordered_map<CollapseKey, size_t, CollapseKeyHash> m_collapseIndex;
+
+    // Earliest flush time required by the levels of the queued messages
+    std::chrono::steady_clock::time_point m_flushDeadline = std::chrono::steady_clock::time_point::max();
+
+    SimpleLogger::AdaptiveBatching m_adaptiveBatching;
+
+    // Arrival of the previous batched message with fixed intervals
+    std::chrono::steady_clock::time_point m_lastBatchedTime = std::chrono::steady_clock::now();
+
+    // Arrival of the previous message and the moving average of the gaps between messages
+    std::chrono::steady_clock::time_point m_lastMessageTime;
+    std::chrono::steady_clock::duration m_averageGap {};
+
+    // Flushes requested with flushAsync() are done on this thread. All requests pending when a flush
+    // starts are completed by that flush.
+    std::mutex m_flushMutex;
+    std::condition_variable m_flushRequested;
+    std::vector<std::promise<void>> m_flushWaiters;
+    std::chrono::steady_clock::time_point m_scheduledFlush = std::chrono::steady_clock::time_point::max();
+    bool m_stopFlusher = false;
+    std::thread m_flusher;
+};
+
+SimpleLogger::Context::Impl::Impl(const SimpleLogger::Config & config)
+  : m_echoMode { config.echoMode }
+  , m_timestampMode { config.timestampMode }
+  , m_timestampSeparator { config.timestampSeparator }
+  , m_customTimestampFormat { config.customTimestampFormat }
+  , m_layout { compilePattern(config.pattern) }
+  , m_multiLineMode { config.multiLineMode }
+  , m_clock { config.clockSource }
+  , m_batchQueue { config.batchMemoryResource }
+  , m_renderThreads { config.renderThreads }
+  , m_adaptiveBatching { config.adaptiveBatching }
+{
+    m_collapseRepeated.fill(config.collapseRepeatedMessages);
+    m_batchIntervals.fill(config.batchInterval);
+    enableFastEchoMode(config.fastEchoMode);
+    initialize(config.filename, config.append);
+
+    auto && registry = Impl::registry();
+    std::lock_guard<std::mutex> lock { registry.mutex };
+    registry.contexts.push_back(this);
+}
+
+void SimpleLogger::Context::Impl::enableEchoMode(bool enable)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_echoMode = enable;
+}
+
+void SimpleLogger::Context::Impl::enableFastEchoMode(bool enable)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    if (enable) {
+        m_echoSink = std::make_unique<SinkSlot>(std::make_shared<ConsoleSink>(), SimpleLogger::SinkOptions {});
+    } else {
+        m_echoSink = std::make_unique<SinkSlot>(m_echoStreamSink, SimpleLogger::SinkOptions {});
+    }
+}
+
+void SimpleLogger::Context::Impl::setLevelSymbol(Level level, std::string symbol)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_symbols[level] = symbol;
+}
+
+void SimpleLogger::Context::Impl::setCustomTimestampFormat(std::string customTimestampFormat)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_customTimestampFormat = customTimestampFormat;
+}
+
+void SimpleLogger::Context::Impl::setTimestampMode(TimestampMode timestampMode)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_timestampMode = timestampMode;
+}
+
+void SimpleLogger::Context::Impl::setTimestampSeparator(std::string separator)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_timestampSeparator = separator;
+}
+
+void SimpleLogger::Context::Impl::setMultiLineMode(SimpleLogger::MultiLineMode multiLineMode)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_multiLineMode = multiLineMode;
+}
+
+void SimpleLogger::Context::Impl::setClockSource(SimpleLogger::ClockSource clockSource)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    // Queued ticks can only be converted by the clock that captured them
+    flush();
+    m_clock = Clock { clockSource };
+}
+
+void SimpleLogger::Context::Impl::setPattern(std::string pattern)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_layout = compilePattern(pattern);
+}
+
+void SimpleLogger::Context::Impl::setBatchInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_batchIntervals.fill(interval);
+    if (!interval.count()) {
+        flush();
+    }
+}
+
+void SimpleLogger::Context::Impl::setBatchInterval(SimpleLogger::Level level, std::chrono::milliseconds interval)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    if (level < SimpleLogger::Level::None) {
+        m_batchIntervals[static_cast<size_t>(level)] = interval;
+        if (!interval.count()) {
+            flush();
+        }
+    }
+}
+
+void SimpleLogger::Context::Impl::setAdaptiveBatching(const SimpleLogger::AdaptiveBatching & settings)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    flush();
+    m_adaptiveBatching = settings;
+    m_lastMessageTime = {};
+}
+
+void SimpleLogger::Context::Impl::setCollapseRepeatedMessages(bool collapse)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_collapseRepeated.fill(collapse);
+}
+
+void SimpleLogger::Context::Impl::setCollapseRepeatedMessages(SimpleLogger::Level level, bool collapse)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    if (level < SimpleLogger::Level::None) {
+        m_collapseRepeated[static_cast<size_t>(level)] = collapse;
+    }
+}
+
+void SimpleLogger::Context::Impl::setRenderThreads(size_t threads)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    if (threads != m_renderThreads) {
+        m_renderThreads = threads;
+        m_renderPool.reset();
+    }
+}
+
+void SimpleLogger::Context::Impl::setStream(Level level, std::ostream & stream)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_echoStreamSink->setStream(level, stream);
+}
+
+void SimpleLogger::Context::Impl::addSink(SinkPtr sink, const SinkOptions & options)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_sinks.push_back(std::make_unique<SinkSlot>(std::move(sink), options));
+}
+
+void SimpleLogger::Context::Impl::removeSink(const SinkPtr & sink)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_sinks.erase(std::remove_if(m_sinks.begin(), m_sinks.end(), [&](auto && slot) { return slot->sink() == sink; }), m_sinks.end());
+}
+
+void SimpleLogger::Context::Impl::setTraceSink(SinkPtr sink)
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    writeTrace();
+    m_traceSink = sink ? std::make_unique<SinkSlot>(std::move(sink), SimpleLogger::SinkOptions {}) : nullptr;
+    m_tracedThreads.clear();
+}
+
+std::chrono::system_clock::time_point SimpleLogger::Context::Impl::spanStart()
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    return m_clock.toTimePoint(m_clock.now());
+}
+
+void SimpleLogger::Context::Impl::endSpan(std::string_view name, std::string_view tag, const SimpleLogger::SourceLocation & location, SimpleLogger::Level level, std::chrono::system_clock::time_point startTime)
+{
+    auto && thread = currentThread();
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    const auto endTicks = m_clock.now();
+    const auto start = std::chrono::duration_cast<std::chrono::nanoseconds>(startTime.time_since_epoch());
+    const auto end = std::chrono::duration_cast<std::chrono::nanoseconds>(m_clock.toTimePoint(endTicks).time_since_epoch());
+
+    if (!m_traceSink) {
+        m_spanMessage.assign(name);
+        m_spanMessage += " took ";
+        appendThousandths(m_spanMessage, (end - start).count() / 1000);
+        m_spanMessage += " ms";
+        m_spanMessage += thread.fieldsText;
+        output({ endTicks, thread.id, thread.name, location, level, tag, m_spanMessage });
+        return;
+    }
+
+    // Complete events nest by time on each thread, so nested spans show up as a flame chart
+    const auto pid = processId();
+    if (!thread.name->empty() && m_tracedThreads.insert(thread.id).second) {
+        m_traceOffsets.push_back(m_traceText.size());
+        m_traceText += R"({"name":"thread_name","ph":"M","pid":)";
+        appendNumber(m_traceText, pid);
+        m_traceText += R"(,"tid":)";
+        appendNumber(m_traceText, static_cast<int64_t>(thread.id));
+        m_traceText += R"(,"args":{"name":)";
+        appendJsonString(m_traceText, *thread.name);
+        m_traceText += "}}";
+        m_traceRecords.push_back({ level, {}, startTime });
+    }
+
+    m_traceOffsets.push_back(m_traceText.size());
+    m_traceText += R"({"name":)";
+    appendJsonString(m_traceText, name);
+    m_traceText += R"(,"cat":)";
+    appendJsonString(m_traceText, tag);
+    m_traceText += R"(,"ph":"X","ts":)";
+    appendThousandths(m_traceText, start.count());
+    m_traceText += R"(,"dur":)";
+    appendThousandths(m_traceText, (end - start).count());
+    m_traceText += R"(,"pid":)";
+    appendNumber(m_traceText, pid);
+    m_traceText += R"(,"tid":)";
+    appendNumber(m_traceText, static_cast<int64_t>(thread.id));
+    if (!thread.fields.empty()) {
+        m_traceText += R"(,"args":)";
+        char delimiter = '{';
+        forEachField(thread.fields, [this, &delimiter](auto && field) {
+            m_traceText += delimiter;
+            appendJsonString(m_traceText, field.key);
+            m_traceText += ':';
+            appendJsonString(m_traceText, field.value);
+            delimiter = ',';
+        });
+        m_traceText += '}';
+    }
+    m_traceText += '}';
+    m_traceRecords.push_back({ level, {}, startTime });
+
+    if (m_traceRecords.size() >= TraceBatchSize) {
+        writeTrace();
+    }
+}
+
+void SimpleLogger::Context::Impl::writeTrace()
+{
+    if (m_traceRecords.empty()) {
+        return;
+    }
+
+    m_traceOffsets.push_back(m_traceText.size());
+    for (size_t i = 0; i < m_traceRecords.size(); i++) {
+        m_traceRecords[i].text = std::string_view { m_traceText }.substr(m_traceOffsets[i], m_traceOffsets[i + 1] - m_traceOffsets[i]);
+    }
+
+    // Cleared also if the sink throws, so that it doesn't make every later write fail
+    const auto clear = [this] {
+        m_traceRecords.clear();
+        m_traceText.clear();
+        m_traceOffsets.clear();
+    };
+    try {
+        if (m_traceSink) {
+            m_traceSink->write(m_traceRecords);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+    clear();
+}
+
+void SimpleLogger::Context::Impl::writeToSinks(const std::vector<SimpleLogger::Record> & records)
+{
+    // The synchronous sinks get views of the rendered lines. The records are copied once for all
+    // the asynchronous sinks.
+    std::shared_ptr<const SharedRecords> shared;
+    const auto write = [&](SinkSlot & slot) {
+        if (slot.isAsync()) {
+            if (!shared) {
+                shared = shareRecords(records);
+            }
+            slot.write(shared);
+        } else {
+            slot.write(records);
+        }
+    };
+
+    if (m_fileSink) {
+        write(*m_fileSink);
+    }
+    if (m_echoMode) {
+        write(*m_echoSink);
+    }
+    for (auto && sink : m_sinks) {
+        write(*sink);
+    }
+}
+
+std::shared_ptr<const SharedRecords> SimpleLogger::Context::Impl::shareRecords(const std::vector<SimpleLogger::Record> & records)
+{
+    std::shared_ptr<SharedRecords> shared;
+    for (auto && block : m_sharedRecords) {
+        if (block.use_count() == 1) {
+            // Synchronizes with the release of the last reference by a worker
+            std::atomic_thread_fence(std::memory_order_acquire);
+            shared = block;
+            break;
+        }
+    }
+    if (!shared) {
+        shared = std::make_shared<SharedRecords>();
+        if (m_sharedRecords.size() < MaxSharedRecords) {
+            m_sharedRecords.push_back(shared);
+        }
+    }
+    shared->assign(records);
+    return shared;
+}
+
+SimpleLogger::Context::Impl::~Impl()
+{
+    {
+        auto && registry = Impl::registry();
+        std::lock_guard<std::mutex> lock { registry.mutex };
+        registry.contexts.erase(std::remove(registry.contexts.begin(), registry.contexts.end(), this), registry.contexts.end());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock { m_flushMutex };
+        m_stopFlusher = true;
+    }
+    m_flushRequested.notify_one();
+    if (m_flusher.joinable()) {
+        m_flusher.join();
+    }
+}
+
+void SimpleLogger::Context::Impl::scheduleFlush(std::chrono::steady_clock::time_point deadline)
+{
+    {
+        std::lock_guard<std::mutex> lock { m_flushMutex };
+        if (deadline >= m_scheduledFlush) {
+            return;
+        }
+        m_scheduledFlush = deadline;
+        if (!m_flusher.joinable()) {
+            m_flusher = std::thread { &SimpleLogger::Context::Impl::runFlusher, this };
+        }
+    }
+    m_flushRequested.notify_one();
+}
+
+void SimpleLogger::Context::Impl::flushExpired()
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    if (std::chrono::steady_clock::now() >= m_flushDeadline) {
+        flush();
+    } else if (m_flushDeadline != std::chrono::steady_clock::time_point::max()) {
+        // The timer was set for an earlier batch that has already been flushed
+        scheduleFlush(m_flushDeadline);
+    }
+}
+
+std::chrono::steady_clock::duration SimpleLogger::Context::Impl::adaptiveInterval(std::chrono::steady_clock::time_point now)
+{
+    const std::chrono::steady_clock::duration maxInterval = m_adaptiveBatching.maxInterval;
+    const auto gap = now - m_lastMessageTime;
+    m_lastMessageTime = now;
+
+    // A message after a pause is written immediately, and the rate is estimated anew
+    if (gap >= maxInterval) {
+        m_averageGap = maxInterval;
+        return {};
+    }
+    m_averageGap += (gap - m_averageGap) / 8;
+
+    // Batching pays off only if several messages are expected within the interval
+    const auto expected = static_cast<double>(maxInterval.count()) / static_cast<double>(std::max<std::chrono::steady_clock::duration::rep>(m_averageGap.count(), 1));
+    if (expected < 2) {
+        return {};
+    }
+    const auto load = std::min(1.0, expected / static_cast<double>(std::max<size_t>(m_adaptiveBatching.maxEntries, 1)));
+    const std::chrono::steady_clock::duration minInterval = m_adaptiveBatching.minInterval;
+    return minInterval + std::chrono::duration_cast<std::chrono::steady_clock::duration>((maxInterval - minInterval) * load);
+}
+
+std::future<void> SimpleLogger::Context::Impl::flushAsync()
+{
+    std::lock_guard<std::mutex> lock { m_flushMutex };
+    if (!m_flusher.joinable()) {
+        m_flusher = std::thread { &SimpleLogger::Context::Impl::runFlusher, this };
+    }
+    m_flushWaiters.emplace_back();
+    auto future = m_flushWaiters.back().get_future();
+    m_flushRequested.notify_one();
+    return future;
+}
+
+void SimpleLogger::Context::Impl::runFlusher()
+{
+    std::vector<std::promise<void>> waiters;
+    for (;;) {
+        bool expired = false;
+        {
+            std::unique_lock<std::mutex> lock { m_flushMutex };
+            const auto ready = [this, &expired] {
+                expired = std::chrono::steady_clock::now() >= m_scheduledFlush;
+                return m_stopFlusher || !m_flushWaiters.empty() || expired;
+            };
+            while (!ready()) {
+                if (m_scheduledFlush == std::chrono::steady_clock::time_point::max()) {
+                    m_flushRequested.wait(lock);
+                } else {
+                    m_flushRequested.wait_until(lock, m_scheduledFlush);
+                }
+            }
+            if (m_stopFlusher && m_flushWaiters.empty()) {
+                return;
+            }
+            if (expired) {
+                m_scheduledFlush = std::chrono::steady_clock::time_point::max();
+            }
+            std::swap(waiters, m_flushWaiters);
+        }
+
+        if (waiters.empty()) {
+            try {
+                flushExpired();
+            } catch (...) {
+                // There's nobody to report to on the flusher thread
+            }
+            continue;
+        }
+
+        try {
+            drain(std::chrono::steady_clock::time_point::max());
+            for (auto && waiter : waiters) {
+                waiter.set_value();
+            }
+        } catch (...) {
+            for (auto && waiter : waiters) {
+                waiter.set_exception(std::current_exception());
+            }
+        }
+
+        waiters.clear();
+    }
+}
+
+bool SimpleLogger::Context::Impl::drain(std::chrono::steady_clock::time_point deadline)
+{
+    std::vector<std::future<void>> written;
+    {
+        std::lock_guard<ContextMutex> lock { m_mutex };
+        flush();
+        for (auto && sink : m_sinks) {
+            const auto promise = std::make_shared<std::promise<void>>();
+            written.push_back(promise->get_future());
+            sink->onWritten([promise] { promise->set_value(); });
+        }
+    }
+    // Asynchronous sinks are waited for without blocking the loggers
+    for (auto && future : written) {
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            future.wait();
+        } else if (future.wait_until(deadline) == std::future_status::timeout) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SimpleLogger::Context::Impl::disableBatching()
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+    m_batchIntervals.fill(std::chrono::milliseconds(0));
+    m_adaptiveBatching.enabled = false;
+    flush();
+}
+
+SimpleLogger::Context::Impl::Registry & SimpleLogger::Context::Impl::registry()
+{
+    static const auto registry = [] {
+        // Contexts still alive at exit, e.g. leaked or destroyed after the handler has run, are drained
+        std::atexit(&Impl::drainAtExit);
+        return new Registry;
+    }();
+    return *registry;
+}
+
+void SimpleLogger::Context::Impl::drainAtExit()
+{
+    auto && registry = Impl::registry();
+    std::lock_guard<std::mutex> lock { registry.mutex };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (auto && context : registry.contexts) {
+        try {
+            context->drain(deadline);
+        } catch (...) {
+            // Nobody to report to at exit
+        }
+    }
+}
+
+bool SimpleLogger::Context::Impl::shutdownAll(std::chrono::steady_clock::time_point deadline)
+{
+    auto && registry = Impl::registry();
+    std::lock_guard<std::mutex> lock { registry.mutex };
+    bool drained = true;
+    for (auto && context : registry.contexts) {
+        try {
+            context->disableBatching();
+            drained = context->drain(deadline) && drained;
+        } catch (...) {
+            drained = false;
+        }
+    }
+    return drained;
+}
+
+namespace {
+
+const std::array<int, 6> emergencySignals = {
+    SIGABRT,
+    SIGFPE,
+    SIGILL,
+    SIGSEGV,
+    SIGTERM,
+#ifdef SIGBUS
+    SIGBUS
+#else
+    0
+#endif
+};
+
+std::array<void (*)(int), 6> previousSignalHandlers {};
+
+} // namespace
+
+void SimpleLogger::Context::Impl::emergencyFlush(int signal)
+{
+    // Best effort: nothing here is async-signal-safe. Locks are only tried so that a crash while
+    // a lock is held can't hang the process. A context locked by this thread is in the middle of an
+    // update, so it's skipped too.
+    auto && registry = Impl::registry();
+    if (registry.mutex.try_lock()) {
+        for (auto && context : registry.contexts) {
+            if (!context->m_mutex.isHeldByCurrentThread() && context->m_mutex.try_lock()) {
+                try {
+                    context->flush();
+                } catch (...) {
+                }
+                context->m_mutex.unlock();
+            }
+        }
+        registry.mutex.unlock();
+    }
+
+    // Let the previous handler or the default action handle the signal
+    auto previous = SIG_DFL;
+    for (size_t i = 0; i < emergencySignals.size(); i++) {
+        if (emergencySignals[i] == signal && previousSignalHandlers[i] && previousSignalHandlers[i] != SIG_ERR) {
+            previous = previousSignalHandlers[i];
+        }
+    }
+    std::signal(signal, previous);
+    std::raise(signal);
+}
+
+void SimpleLogger::Context::Impl::enableEmergencyFlush(bool enable)
+{
+    registry(); // Not to be created in the handler
+    for (size_t i = 0; i < emergencySignals.size(); i++) {
+        if (!emergencySignals[i]) {
+            continue;
+        }
+        if (enable) {
+            const auto previous = std::signal(emergencySignals[i], &Impl::emergencyFlush);
+            if (previous != &Impl::emergencyFlush) {
+                previousSignalHandlers[i] = previous;
+            }
+        } else if (previousSignalHandlers[i]) {
+            std::signal(emergencySignals[i], previousSignalHandlers[i]);
+            previousSignalHandlers[i] = nullptr;
+        }
+    }
+}
+
+void SimpleLogger::Context::Impl::flush()
+{
+    std::lock_guard<ContextMutex> lock { m_mutex };
+
+    writeTrace();
+
+    if (m_batchQueue.empty()) {
+        // The sinks may hold output from earlier writes, e.g. a socket sink while disconnected
+        for (auto && slot : m_sinks) {
+            slot->flush();
+        }
+        return;
+    }
+
+    m_batchEntries.clear();
+    m_batchCounts.clear();
+    m_collapseIndex.clear();
+    m_batchQueue.forEach([this](const BatchEntry & entry) {
+        if (m_collapseRepeated[static_cast<size_t>(entry.level)]) {
+            // Same text with a different level or tag is a different message
+            const CollapseKey key { entry.level, entry.tag(), entry.message() };
+            if (auto && it = m_collapseIndex.find(key); it != m_collapseIndex.end()) {
+                m_batchCounts[it->second]++;
+            } else {
+                m_collapseIndex.emplace(key, m_batchEntries.size());
+                m_batchEntries.push_back(&entry);
+                m_batchCounts.push_back(1);
+            }
+        } else {
+            m_batchEntries.push_back(&entry);
+            m_batchCounts.push_back(1);
+        }
+    });
+
+    // The clock may resync, so the times are converted on this thread
+    m_batchRecords.clear();
+    for (auto && entry : m_batchEntries) {
+        m_batchRecords.push_back({ entry->level, {}, m_clock.toTimePoint(entry->ticks) });
+    }
+
+    // Consecutive parts of the batch are rendered into separate buffers and the records refer to them
+    size_t threads = 1;
+    if (m_batchEntries.size() >= ParallelRenderThreshold) {
+        threads = m_renderThreads ? m_renderThreads : std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4);
+    }
+    if (threads > 1 && !m_renderPool) {
+        m_renderPool = std::make_unique<RenderPool>(threads - 1);
+    }
+    if (m_renderChunks.size() < threads) {
+        m_renderChunks.resize(threads);
+    }
+    const auto chunkSize = (m_batchEntries.size() + threads - 1) / threads;
+    auto job = [this, chunkSize](size_t index) {
+        const auto begin = std::min(index * chunkSize, m_batchEntries.size());
+        renderBatch(m_renderChunks[index], begin, std::min(begin + chunkSize, m_batchEntries.size()));
+    };
+    if (threads > 1) {
+        m_renderPool->run(threads, job);
+    } else {
+        job(0);
+    }
+
+    // Reset before writing so that a throwing sink doesn't make every later flush fail
+    m_batchQueue.reset();
+    m_flushDeadline = std::chrono::steady_clock::time_point::max();
+
+    writeToSinks(m_batchRecords);
+}
+
+void SimpleLogger::Context::Impl::initialize(std::string filename, bool append)
+{
+    if (!filename.empty()) {
+        std::lock_guard<ContextMutex> lock { m_mutex };
+        m_fileSink = std::make_unique<SinkSlot>(std::make_shared<FileSink>(filename, append), SimpleLogger::SinkOptions {});
+    }
+}
+
+ContextMutex & SimpleLogger::Context::Impl::mutex()
+{
+    return m_mutex;
+}
+
+uint64_t SimpleLogger::Context::Impl::clockTicks() const
+{
+    return m_clock.now();
+}
+
+void SimpleLogger::Context::Impl::renderBatch(RenderChunk & chunk, size_t begin, size_t end)
+{
+    chunk.text.clear();
+    chunk.offsets.clear();
+    for (size_t i = begin; i < end; i++) {
+        auto && entry = *m_batchEntries[i];
+        chunk.offsets.push_back(chunk.text.size());
+        render(chunk.text, { entry.ticks, entry.threadId, entry.threadName, entry.location, entry.level, entry.tag(), entry.message() }, m_batchRecords[i].time);
+        if (m_batchCounts[i] > 1) {
+            chunk.text += " (x";
+            appendNumber(chunk.text, static_cast<int64_t>(m_batchCounts[i]));
+            chunk.text += ')';
+        }
+    }
+    chunk.offsets.push_back(chunk.text.size());
+    for (size_t i = begin; i < end; i++) {
+        m_batchRecords[i].text = std::string_view { chunk.text }.substr(chunk.offsets[i - begin], chunk.offsets[i - begin + 1] - chunk.offsets[i - begin]);
+    }
+}
+
+void SimpleLogger::Context::Impl::appendMessage(std::string & out, size_t lineStart, std::string_view text) const
+{
+    using Mode = SimpleLogger::MultiLineMode;
+
+    if (m_multiLineMode == Mode::Keep) {
+        out.append(text);
+        return;
+    }
+
+    const auto escape = m_multiLineMode == Mode::Escape;
+    const auto find = [escape](std::string_view text) {
+        return escape ? findLineBreak<true>(text) : findLineBreak<false>(text);
+    };
+
+    auto position = find(text);
+    if (position == std::string_view::npos) {
+        out.append(text);
+        return;
+    }
+
+    if (escape) {
+        do {
+            out.append(text.substr(0, position));
+            appendEscaped(out, text[position]);
+            text.remove_prefix(position + 1);
+            position = find(text);
+        } while (position != std::string_view::npos);
+        out.append(text);
+        return;
+    }
+
+    // A trailing newline doesn't start a line
+    if (text.back() == '\n') {
+        text.remove_suffix(1);
+        position = find(text);
+    }
+
+    const auto prefixSize = out.size() - lineStart;
+    while (position != std::string_view::npos) {
+        out.append(text.substr(0, position));
+        out.push_back('\n');
+        if (m_multiLineMode == Mode::Prefix) {
+            out.append(out, lineStart, prefixSize);
+        } else {
+            out.append(prefixSize, ' ');
+        }
+        text.remove_prefix(position + 1);
+        position = find(text);
+    }
+    out.append(text);
+}
+
+void SimpleLogger::Context::Impl::render(std::string & out, const MessageView & message, std::chrono::system_clock::time_point time) const
+{
+    const auto lineStart = out.size();
+    for (auto && op : m_layout) {
+        switch (op.type) {
+        case LayoutOp::Type::Literal:
+            out.append(op.text);
+            break;
+        case LayoutOp::Type::Timestamp:
+            if (op.timestampMode) {
+                appendTimestamp(out, *op.timestampMode, op.text, time);
+            } else {
+                appendTimestamp(out, m_timestampMode, m_customTimestampFormat, time);
+            }
+            break;
+        case LayoutOp::Type::LegacyTimestamp:
+            if (m_timestampMode != SimpleLogger::TimestampMode::None) {
+                const auto size = out.size();
+                appendTimestamp(out, m_timestampMode, m_customTimestampFormat, time);
+                if (out.size() != size) {
+                    out.append(m_timestampSeparator);
+                }
+            }
+            break;
+        case LayoutOp::Type::LevelSymbol:
+            out.append(m_symbols.at(message.level));
+            break;
+        case LayoutOp::Type::Tag:
+            out.append(message.tag);
+            break;
+        case LayoutOp::Type::LegacyTag:
+            if (!message.tag.empty()) {
+                out.push_back(' ');
+                out.append(message.tag);
+                out.push_back(':');
+            }
+            break;
+        case LayoutOp::Type::ThreadId:
+            appendNumber(out, static_cast<int64_t>(message.threadId));
+            break;
+        case LayoutOp::Type::ThreadName:
+            out.append(*message.threadName);
+            break;
+        case LayoutOp::Type::File:
+            if (message.location.file) {
+                out.append(message.location.file);
+            }
+            break;
+        case LayoutOp::Type::Line:
+            if (message.location.line) {
+                appendNumber(out, message.location.line);
+            }
+            break;
+        case LayoutOp::Type::Function:
+            if (message.location.function) {
+                out.append(message.location.function);
+            }
+            break;
+        case LayoutOp::Type::Message:
+            appendMessage(out, lineStart, message.text);
+            break;
+        }
+    }
+}
+
+void SimpleLogger::Context::Impl::output(const MessageView & message)
+{
+    const auto adaptive = m_adaptiveBatching.enabled;
+    const auto now = adaptive ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {};
+    const auto interval = adaptive ? adaptiveInterval(now) : m_batchIntervals[static_cast<size_t>(message.level)];
+    if (interval.count() > 0 || !m_batchQueue.empty()) {
+        // Message is rendered only when the batch is flushed. An unbatched level flushes the pending
+        // batch together with the message, which keeps the order.
+        m_batchQueue.push({ message.ticks, message.threadId, message.threadName, message.location, message.level, 0, 0 }, message.tag, message.text);
+
+        const auto pushed = adaptive ? now : std::chrono::steady_clock::now();
+
+        // A message after a pause of its interval is written immediately. Otherwise the flusher
+        // thread writes the batch when the interval expires, also if nothing else is logged.
+        const auto idle = !adaptive && pushed - m_lastBatchedTime >= interval;
+        m_lastBatchedTime = pushed;
+        if (!idle && interval.count() > 0 && pushed + interval < m_flushDeadline) {
+            m_flushDeadline = pushed + interval;
+            scheduleFlush(m_flushDeadline);
+        }
+        const auto full = adaptive && (m_batchQueue.size() >= m_adaptiveBatching.maxEntries || m_batchQueue.bytes() >= m_adaptiveBatching.maxBytes);
+        if (!interval.count() || idle || pushed >= m_flushDeadline || full) {
+            flush();
+        }
+    } else {
+        const auto time = m_clock.toTimePoint(message.ticks);
+        m_line.clear();
+        render(m_line, message, time);
+        m_records.clear();
+        m_records.push_back({ message.level, m_line, time });
+        writeToSinks(m_records);
+    }
+}
+
+//! std::ostream writing into a LogStream, used for types without a native LogStream operator.
+class SimpleLogger::LogStream::Formatter : private std::streambuf, public std::ostream
 {
 public:
-    Impl();
-    Impl(const std::string & tag);
-    ~Impl();
-
-    std::ostringstream & traceStream();
-    std::ostringstream & debugStream();
-    std::ostringstream & infoStream();
-    std::ostringstream & warningStream();
-    std::ostringstream & errorStream();
-    std::ostringstream & fatalStream();
-
-    static void enableEchoMode(bool enable);
-
-    static void setLevelSymbol(SimpleLogger::Level level, std::string symbol);
-    static void setLoggingLevel(SimpleLogger::Level level);
-    static void setCustomTimestampFormat(std::string format);
-    static void setTimestampMode(SimpleLogger::TimestampMode timestampMode);
-    static void setTimestampSeparator(std::string separator);
-    static void setBatchInterval(std::chrono::milliseconds interval);
-    static void setCollapseRepeatedMessages(bool collapse);
-    static void setStream(Level level, std::ostream & stream);
-
-    static void flush();
+    explicit Formatter(LogStream & stream)
+      : std::ostream { this }
+      , m_stream { stream }
+    {
+    }
 
-    static void initialize(std::string filename, bool append);
+private:
+    using Traits = std::streambuf::traits_type;
 
-    void flushCurrentMessage();
+    std::streambuf::int_type overflow(std::streambuf::int_type c) override
+    {
+        if (!Traits::eq_int_type(c, Traits::eof())) {
+            const auto character = Traits::to_char_type(c);
+            m_stream.write(&character, 1);
+        }
+        return Traits::not_eof(c);
+    }
 
-    std::ostringstream & prepareStreamForLoggingLevel(SimpleLogger::Level level);
+    std::streamsize xsputn(const char * data, std::streamsize size) override
+    {
+        m_stream.write(data, static_cast<size_t>(size));
+        return size;
+    }
 
-private:
-    std::string currentDateTime(std::chrono::time_point<std::chrono::system_clock> now, const std::string & dateTimeFormat) const;
+    LogStream & m_stream;
+};
 
-    void flushFileIfOpen();
-    void flushEchoIfEnabled();
+namespace {
 
-    void prefixWithLevelAndTag(SimpleLogger::Level level);
-    void prefixWithTimestamp();
+//! Heap buffer reused by the long messages of a thread.
+struct ThreadLocalBuffer
+{
+    std::string data;
 
-    bool shouldFlush() const;
+    bool inUse = false;
+};
 
-    static bool m_echoMode;
-    static bool m_collapseRepeated;
+thread_local ThreadLocalBuffer threadLocalBuffer;
 
-    static SimpleLogger::Level m_level;
-    static SimpleLogger::TimestampMode m_timestampMode;
+} // namespace
 
-    static std::string m_timestampSeparator;
-    static std::string m_customTimestampFormat;
+void SimpleLogger::LogStream::grow(size_t capacity)
+{
+    if (!m_buffer) {
+        // The thread-local buffer might be taken by a message being built while this one is
+        if (!threadLocalBuffer.inUse) {
+            threadLocalBuffer.inUse = true;
+            m_buffer = &threadLocalBuffer.data;
+        } else {
+            m_buffer = new std::string;
+        }
+        m_buffer->resize(std::max(capacity, std::max(m_buffer->capacity(), InlineCapacity * 4)));
+        std::memcpy(m_buffer->data(), m_data, m_size);
+    } else {
+        m_buffer->resize(std::max(capacity, m_buffer->size() * 2));
+    }
+    m_data = m_buffer->data();
+    m_capacity = m_buffer->size();
+}
 
-    static std::ofstream m_fileStream;
+void SimpleLogger::LogStream::release()
+{
+    delete m_formatter;
+    m_formatter = nullptr;
 
-    using SymbolMap = std::map<SimpleLogger::Level, std::string>;
-    static SymbolMap m_symbols;
+    if (m_buffer == &threadLocalBuffer.data) {
+        threadLocalBuffer.inUse = false;
+    } else {
+        delete m_buffer;
+    }
+    m_buffer = nullptr;
+}
 
-    using StreamMap = std::map<SimpleLogger::Level, std::ostream *>;
-    static StreamMap m_streams;
+std::ostream & SimpleLogger::LogStream::formatter()
+{
+    if (!m_formatter) {
+        m_formatter = new Formatter { *this };
+    }
+    return *m_formatter;
+}
 
-    static std::recursive_mutex m_mutex;
+bool SimpleLogger::LogStream::isFormatterCustomized() const
+{
+    static const std::ostream::fmtflags defaultFlags = std::ios_base::dec | std::ios_base::skipws;
+    return m_formatter->flags() != defaultFlags || m_formatter->precision() != 6 || m_formatter->width() != 0;
+}
 
-    struct LogEntry
-    {
-        std::string timestamp;
-        std::string message;
-        SimpleLogger::Level level;
-    };
-    static std::vector<LogEntry> m_batchQueue;
-    static std::chrono::milliseconds m_batchInterval;
-    static std::chrono::steady_clock::time_point m_lastFlushTime;
+SimpleLogger::LogStream & SimpleLogger::LogStream::operator<<(std::ostream & (*manipulator)(std::ostream &))
+{
+    using Manipulator = std::ostream & (*)(std::ostream &);
+    if (manipulator == static_cast<Manipulator>(std::endl)) {
+        *this << '\n';
+    } else if (m_discard) {
+        return *this;
+    } else if (manipulator == static_cast<Manipulator>(std::ends)) {
+        *this << '\0';
+    } else if (manipulator != static_cast<Manipulator>(std::flush)) {
+        formatter() << manipulator;
+    }
+    return *this;
+}
 
-    SimpleLogger::Level m_activeLevel = SimpleLogger::Level::Info;
+SimpleLogger::Context::Context()
+  : Context(Config {})
+{
+}
 
-    std::lock_guard<std::recursive_mutex> m_lock;
+SimpleLogger::Context::Context(const Config & config)
+  : m_impl(std::make_unique<SimpleLogger::Context::Impl>(config))
+  , m_level { config.level }
+{
+}
 
-    std::string m_tag;
-    std::string m_logEntryTimestamp;
+SimpleLogger::Context::~Context()
+{
+    m_impl->flush();
+}
 
-    std::ostringstream m_message;
-};
+std::future<void> SimpleLogger::Context::flushAsync()
+{
+    return m_impl->flushAsync();
+}
 
-bool SimpleLogger::Impl::m_echoMode = true;
-bool SimpleLogger::Impl::m_collapseRepeated = false;
+void SimpleLogger::Context::initialize(std::string filename, bool append)
+{
+    m_impl->initialize(filename, append);
+}
 
-SimpleLogger::Level SimpleLogger::Impl::m_level = SimpleLogger::Level::Info;
-SimpleLogger::TimestampMode SimpleLogger::Impl::m_timestampMode = SimpleLogger::TimestampMode::DateTime;
+void SimpleLogger::Context::enableEchoMode(bool enable)
+{
+    m_impl->enableEchoMode(enable);
+}
 
-std::string SimpleLogger::Impl::m_timestampSeparator = ": ";
-std::string SimpleLogger::Impl::m_customTimestampFormat;
+void SimpleLogger::Context::enableFastEchoMode(bool enable)
+{
+    m_impl->enableFastEchoMode(enable);
+}
 
-std::ofstream SimpleLogger::Impl::m_fileStream;
+void SimpleLogger::Context::setLoggingLevel(Level level)
+{
+    m_level.store(level, std::memory_order_relaxed);
+}
 
-// Default level symbols
-SimpleLogger::Impl::SymbolMap SimpleLogger::Impl::m_symbols = {
-    { SimpleLogger::Level::Trace, "T:" },
-    { SimpleLogger::Level::Debug, "D:" },
-    { SimpleLogger::Level::Info, "I:" },
-    { SimpleLogger::Level::Warning, "W:" },
-    { SimpleLogger::Level::Error, "E:" },
-    { SimpleLogger::Level::Fatal, "F:" }
-};
+void SimpleLogger::Context::setLevelSymbol(Level level, std::string symbol)
+{
+    m_impl->setLevelSymbol(level, symbol);
+}
 
-// Default streams
-SimpleLogger::Impl::StreamMap SimpleLogger::Impl::m_streams = {
-    { SimpleLogger::Level::Trace, &std::cout },
-    { SimpleLogger::Level::Debug, &std::cout },
-    { SimpleLogger::Level::Info, &std::cout },
-    { SimpleLogger::Level::Warning, &std::cerr },
-    { SimpleLogger::Level::Error, &std::cerr },
-    { SimpleLogger::Level::Fatal, &std::cerr }
-};
+void SimpleLogger::Context::setTimestampMode(TimestampMode timestampMode)
+{
+    m_impl->setTimestampMode(timestampMode);
+}
 
-std::recursive_mutex SimpleLogger::Impl::m_mutex;
+void SimpleLogger::Context::setCustomTimestampFormat(std::string customTimestampFormat)
+{
+    m_impl->setTimestampMode(TimestampMode::Custom);
+    m_impl->setCustomTimestampFormat(customTimestampFormat);
+}
 
-std::vector<SimpleLogger::Impl::LogEntry> SimpleLogger::Impl::m_batchQueue;
+void SimpleLogger::Context::setTimestampSeparator(std::string separator)
+{
+    m_impl->setTimestampSeparator(separator);
+}
 
-std::chrono::milliseconds SimpleLogger::Impl::m_batchInterval = std::chrono::milliseconds(0);
+void SimpleLogger::Context::setMultiLineMode(MultiLineMode multiLineMode)
+{
+    m_impl->setMultiLineMode(multiLineMode);
+}
 
-std::chrono::steady_clock::time_point SimpleLogger::Impl::m_lastFlushTime = std::chrono::steady_clock::now();
+void SimpleLogger::Context::setPattern(std::string pattern)
+{
+    m_impl->setPattern(pattern);
+}
 
-SimpleLogger::Impl::Impl()
-  : m_lock { m_mutex }
+void SimpleLogger::Context::setClockSource(ClockSource clockSource)
 {
+    m_impl->setClockSource(clockSource);
 }
 
-SimpleLogger::Impl::Impl(const std::string & tag)
-  : m_lock { m_mutex }
-  , m_tag { tag }
+void SimpleLogger::Context::setBatchInterval(std::chrono::milliseconds interval)
 {
+    m_impl->setBatchInterval(interval);
 }
 
-SimpleLogger::Impl::~Impl()
+void SimpleLogger::Context::setBatchInterval(Level level, std::chrono::milliseconds interval)
 {
-    flushCurrentMessage();
+    m_impl->setBatchInterval(level, interval);
 }
 
-void SimpleLogger::Impl::enableEchoMode(bool enable)
+void SimpleLogger::Context::flush()
 {
-    m_echoMode = enable;
+    m_impl->flush();
 }
 
-std::ostringstream & SimpleLogger::Impl::prepareStreamForLoggingLevel(SimpleLogger::Level level)
+void SimpleLogger::Context::setAdaptiveBatching(const AdaptiveBatching & settings)
 {
-    m_activeLevel = level;
-    prefixWithTimestamp();
-    prefixWithLevelAndTag(level);
-    return m_message;
+    m_impl->setAdaptiveBatching(settings);
 }
 
-void SimpleLogger::Impl::setLevelSymbol(Level level, std::string symbol)
+void SimpleLogger::Context::setCollapseRepeatedMessages(bool collapse)
 {
-    m_symbols[level] = symbol;
+    m_impl->setCollapseRepeatedMessages(collapse);
 }
 
-void SimpleLogger::Impl::setLoggingLevel(SimpleLogger::Level level)
+void SimpleLogger::Context::setCollapseRepeatedMessages(Level level, bool collapse)
 {
-    m_level = level;
+    m_impl->setCollapseRepeatedMessages(level, collapse);
 }
 
-void SimpleLogger::Impl::setCustomTimestampFormat(std::string customTimestampFormat)
+void SimpleLogger::Context::setRenderThreads(size_t threads)
 {
-    m_customTimestampFormat = customTimestampFormat;
+    m_impl->setRenderThreads(threads);
 }
 
-void SimpleLogger::Impl::setTimestampMode(TimestampMode timestampMode)
+void SimpleLogger::Context::setStream(Level level, std::ostream & stream)
 {
-    m_timestampMode = timestampMode;
+    m_impl->setStream(level, stream);
 }
 
-void SimpleLogger::Impl::setTimestampSeparator(std::string separator)
+void SimpleLogger::Context::addSink(SinkPtr sink)
 {
-    m_timestampSeparator = separator;
+    m_impl->addSink(std::move(sink), {});
 }
 
-void SimpleLogger::Impl::setBatchInterval(std::chrono::milliseconds interval)
+void SimpleLogger::Context::addSink(SinkPtr sink, const SinkOptions & options)
 {
-    m_batchInterval = interval;
-    if (!m_batchInterval.count()) {
-        flush();
-    }
+    m_impl->addSink(std::move(sink), options);
 }
 
-void SimpleLogger::Impl::setCollapseRepeatedMessages(bool collapse)
+void SimpleLogger::Context::removeSink(const SinkPtr & sink)
 {
-    m_collapseRepeated = collapse;
+    m_impl->removeSink(sink);
 }
 
-void SimpleLogger::Impl::flush()
+void SimpleLogger::Context::setTraceSink(SinkPtr sink)
 {
-    std::lock_guard<std::recursive_mutex> lock { m_mutex };
+    m_impl->setTraceSink(std::move(sink));
+}
 
-    if (m_batchQueue.empty()) {
-        return;
+SimpleLogger::Sink::~Sink() = default;
+
+#ifndef _WIN32
+
+class SimpleLogger::SharedMemoryCollector::Impl
+{
+public:
+    Impl(std::string name, size_t capacity, SinkPtr sink)
+      : m_name { std::move(name) }
+      , m_ring { SharedMemoryRing::create(m_name, capacity) }
+      , m_sink { std::move(sink) }
+      , m_owner { ::getpid() }
+      , m_thread { std::make_unique<std::thread>(&Impl::run, this) }
+    {
     }
 
-    const auto outputMessage = [&](const std::string & msg, SimpleLogger::Level level) {
-        if (m_fileStream.is_open()) {
-            m_fileStream << msg << std::endl;
-        }
-        if (m_echoMode) {
-            if (auto && stream = m_streams[level]; stream) {
-                *stream << msg << std::endl;
-            }
+    ~Impl()
+    {
+        if (::getpid() != m_owner) {
+            // A forked child has only a copy of the thread object
+            m_thread.release();
+            return;
         }
-    };
 
-    if (m_collapseRepeated) {
-        std::vector<LogEntry> uniqueEntries;
-        std::vector<size_t> counts;
-        std::unordered_map<std::string, size_t> indexMap;
-
-        for (const auto & entry : m_batchQueue) {
-            auto && it = indexMap.find(entry.message);
-            if (it != indexMap.end()) {
-                counts[it->second]++;
-            } else {
-                indexMap[entry.message] = uniqueEntries.size();
-                uniqueEntries.push_back(entry);
-                counts.push_back(1);
-            }
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_stop = true;
         }
+        m_stopRequested.notify_one();
+        m_thread->join();
+        ::shm_unlink(m_name.c_str());
+    }
 
-        for (size_t i = 0; i < uniqueEntries.size(); ++i) {
-            std::string finalMsg = uniqueEntries[i].timestamp + uniqueEntries[i].message;
-            if (counts[i] > 1) {
-                finalMsg += " (x" + std::to_string(counts[i]) + ")";
+private:
+    void run()
+    {
+        for (;;) {
+            const auto drained = drain();
+            std::unique_lock<std::mutex> lock { m_mutex };
+            if (m_stop) {
+                break;
+            }
+            if (!drained) {
+                m_stopRequested.wait_for(lock, PollInterval);
             }
-            outputMessage(finalMsg, uniqueEntries[i].level);
-        }
-    } else {
-        for (const auto & entry : m_batchQueue) {
-            outputMessage(entry.timestamp + entry.message, entry.level);
         }
+        drain();
     }
 
-    if (m_fileStream.is_open()) {
-        m_fileStream.flush();
-    }
-    if (m_echoMode) {
-        // Flush all streams that might have been used
-        for (auto const & [level, stream] : m_streams) {
-            if (stream) stream->flush();
+    size_t drain()
+    {
+        try {
+            return m_ring->drain([this](const std::vector<Record> & records) {
+                m_sink->write(records);
+                m_sink->flush();
+            });
+        } catch (...) {
+            // There's nobody to report to on the collector thread
+            return 0;
         }
     }
 
-    m_batchQueue.clear();
-    m_lastFlushTime = std::chrono::steady_clock::now();
+    static constexpr auto PollInterval = std::chrono::milliseconds(1);
+
+    std::string m_name;
+
+    std::unique_ptr<SharedMemoryRing> m_ring;
+
+    SinkPtr m_sink;
+
+    pid_t m_owner;
+
+    std::mutex m_mutex;
+
+    std::condition_variable m_stopRequested;
+
+    bool m_stop = false;
+
+    std::unique_ptr<std::thread> m_thread;
+};
+
+#else
+
+class SimpleLogger::SharedMemoryCollector::Impl
+{
+};
+
+#endif // _WIN32
+
+SimpleLogger::SharedMemoryCollector::SharedMemoryCollector(std::unique_ptr<Impl> impl)
+  : m_impl { std::move(impl) }
+{
 }
 
-std::string SimpleLogger::Impl::currentDateTime(std::chrono::time_point<std::chrono::system_clock> now, const std::string & dateTimeFormat) const
+SimpleLogger::SharedMemoryCollector::~SharedMemoryCollector() = default;
+
+void SimpleLogger::Sink::flush()
 {
-    std::ostringstream oss;
-    const auto rawTime = std::chrono::system_clock::to_time_t(now);
-    oss << std::put_time(std::localtime(&rawTime), dateTimeFormat.c_str());
+}
 
-    return oss.str();
+SimpleLogger::ContextPtr SimpleLogger::createContext()
+{
+    return std::make_shared<Context>();
 }
 
-void SimpleLogger::Impl::prefixWithLevelAndTag(SimpleLogger::Level level)
+SimpleLogger::ContextPtr SimpleLogger::createContext(const Config & config)
 {
-    m_message << m_symbols[level] << (!m_tag.empty() ? " " + m_tag + ":" : "") << " ";
+    return std::make_shared<Context>(config);
 }
 
-static std::string isoDateTimeMilliseconds()
+SimpleLogger::Context & SimpleLogger::createDefaultContext()
 {
-    using std::chrono::duration_cast;
-    using std::chrono::system_clock;
+    static Context context;
+    s_defaultContext.store(&context, std::memory_order_release);
+    return context;
+}
+
+void SimpleLogger::initialize(std::string filename, bool append)
+{
+    defaultContext().initialize(filename, append);
+}
 
-    const auto now = system_clock::now();
-    const auto nowMs = duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000; // Milliseconds part
-    const auto timeTNow = system_clock::to_time_t(now); // Convert to time_t for strftime
+void SimpleLogger::enableEchoMode(bool enable)
+{
+    defaultContext().enableEchoMode(enable);
+}
 
-    // Format the datetime part
-    std::array<char, 64> datetimeBuffer;
-    std::strftime(datetimeBuffer.data(), datetimeBuffer.size(), "%Y-%m-%dT%H:%M:%S", std::localtime(&timeTNow));
+void SimpleLogger::enableFastEchoMode(bool enable)
+{
+    defaultContext().enableFastEchoMode(enable);
+}
 
-    // Append milliseconds
-    std::ostringstream oss;
-    oss << datetimeBuffer.data() << '.' << std::setfill('0') << std::setw(3) << nowMs.count();
+void SimpleLogger::setLoggingLevel(Level level)
+{
+    defaultContext().setLoggingLevel(level);
+}
 
-    return oss.str();
+void SimpleLogger::setLevelSymbol(Level level, std::string symbol)
+{
+    defaultContext().setLevelSymbol(level, symbol);
 }
 
-void SimpleLogger::Impl::prefixWithTimestamp()
+void SimpleLogger::setTimestampMode(TimestampMode timestampMode)
 {
-    std::string timestamp;
+    defaultContext().setTimestampMode(timestampMode);
+}
 
-    using std::chrono::duration_cast;
-    using std::chrono::system_clock;
+void SimpleLogger::setCustomTimestampFormat(std::string customTimestampFormat)
+{
+    defaultContext().setCustomTimestampFormat(customTimestampFormat);
+}
 
-    switch (m_timestampMode) {
-    case SimpleLogger::TimestampMode::None:
-        break;
-    case SimpleLogger::TimestampMode::DateTime: {
-        timestamp = currentDateTime(system_clock::now(), "%a %b %e %H:%M:%S %Y");
-    } break;
-    case SimpleLogger::TimestampMode::ISODateTime: {
-        timestamp = currentDateTime(system_clock::now(), "%Y-%m-%dT%H:%M:%S");
-    } break;
-    case SimpleLogger::TimestampMode::ISODateTimeMilliseconds: {
-        timestamp = isoDateTimeMilliseconds();
-    } break;
-    case SimpleLogger::TimestampMode::EpochSeconds:
-        timestamp = std::to_string(duration_cast<std::chrono::seconds>(system_clock::now().time_since_epoch()).count());
-        break;
-    case SimpleLogger::TimestampMode::EpochMilliseconds:
-        using std::chrono::duration_cast;
-        timestamp = std::to_string(duration_cast<std::chrono::milliseconds>(system_clock::now().time_since_epoch()).count());
-        break;
-    case SimpleLogger::TimestampMode::EpochMicroseconds:
-        using std::chrono::duration_cast;
-        timestamp = std::to_string(duration_cast<std::chrono::microseconds>(system_clock::now().time_since_epoch()).count());
-        break;
-    case SimpleLogger::TimestampMode::Custom:
-        timestamp = currentDateTime(system_clock::now(), m_customTimestampFormat);
-        break;
-    }
+void SimpleLogger::setTimestampSeparator(std::string timestampSeparator)
+{
+    defaultContext().setTimestampSeparator(timestampSeparator);
+}
 
-    if (!timestamp.empty()) {
-        m_logEntryTimestamp = timestamp + m_timestampSeparator;
-    }
+void SimpleLogger::setMultiLineMode(MultiLineMode multiLineMode)
+{
+    defaultContext().setMultiLineMode(multiLineMode);
 }
 
-bool SimpleLogger::Impl::shouldFlush() const
+void SimpleLogger::setPattern(std::string pattern)
 {
-    return m_activeLevel >= m_level && !m_message.str().empty();
+    defaultContext().setPattern(pattern);
 }
 
-void SimpleLogger::Impl::flushFileIfOpen()
+void SimpleLogger::setThreadName(std::string name)
 {
-    if (m_fileStream.is_open()) {
-        m_fileStream << m_logEntryTimestamp << m_message.str() << std::endl;
-        m_fileStream.flush();
-    }
+    currentThread().name = internThreadName(std::move(name));
 }
 
-void SimpleLogger::Impl::flushEchoIfEnabled()
+void SimpleLogger::setClockSource(ClockSource clockSource)
 {
-    if (m_echoMode) {
-        if (auto && stream = m_streams[m_activeLevel]; stream) {
-            *stream << m_logEntryTimestamp << m_message.str() << std::endl;
-            stream->flush();
-        }
-    }
+    defaultContext().setClockSource(clockSource);
 }
 
-void SimpleLogger::Impl::flushCurrentMessage()
+void SimpleLogger::setBatchInterval(std::chrono::milliseconds interval)
 {
-    if (shouldFlush()) {
-        if (m_batchInterval.count() > 0) {
-            m_batchQueue.push_back({ m_logEntryTimestamp, m_message.str(), m_activeLevel });
+    defaultContext().setBatchInterval(interval);
+}
 
-            const auto now = std::chrono::steady_clock::now();
-            if (now - m_lastFlushTime >= m_batchInterval) {
-                flush();
-            }
-        } else {
-            flushFileIfOpen();
-            flushEchoIfEnabled();
-        }
-    }
+void SimpleLogger::setBatchInterval(Level level, std::chrono::milliseconds interval)
+{
+    defaultContext().setBatchInterval(level, interval);
 }
 
-void SimpleLogger::Impl::initialize(std::string filename, bool append)
+void SimpleLogger::setAdaptiveBatching(const AdaptiveBatching & settings)
 {
-    if (!filename.empty()) {
-        m_fileStream.open(filename, append ? std::ofstream::out | std::ofstream::app : std::ofstream::out);
-        if (!m_fileStream.is_open()) {
-            throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for write.\n");
-        }
-    }
+    defaultContext().setAdaptiveBatching(settings);
 }
 
-std::ostringstream & SimpleLogger::Impl::traceStream()
+void SimpleLogger::setCollapseRepeatedMessages(bool collapse)
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Trace);
+    defaultContext().setCollapseRepeatedMessages(collapse);
 }
 
-std::ostringstream & SimpleLogger::Impl::debugStream()
+void SimpleLogger::setCollapseRepeatedMessages(Level level, bool collapse)
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Debug);
+    defaultContext().setCollapseRepeatedMessages(level, collapse);
 }
 
-std::ostringstream & SimpleLogger::Impl::infoStream()
+void SimpleLogger::setRenderThreads(size_t threads)
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Info);
+    defaultContext().setRenderThreads(threads);
 }
 
-std::ostringstream & SimpleLogger::Impl::warningStream()
+void SimpleLogger::flush()
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Warning);
+    defaultContext().flush();
 }
 
-std::ostringstream & SimpleLogger::Impl::errorStream()
+std::future<void> SimpleLogger::flushAsync()
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Error);
+    return defaultContext().flushAsync();
 }
 
-std::ostringstream & SimpleLogger::Impl::fatalStream()
+bool SimpleLogger::shutdown(std::chrono::steady_clock::time_point deadline)
 {
-    return prepareStreamForLoggingLevel(SimpleLogger::Level::Fatal);
+    return Context::Impl::shutdownAll(deadline);
 }
 
-void SimpleLogger::Impl::setStream(Level level, std::ostream & stream)
+void SimpleLogger::enableEmergencyFlush(bool enable)
 {
-    m_streams[level] = &stream;
+    Context::Impl::enableEmergencyFlush(enable);
 }
 
-SimpleLogger::SimpleLogger()
-  : m_impl(std::make_unique<SimpleLogger::Impl>())
+void SimpleLogger::setStream(Level level, std::ostream & stream)
 {
+    defaultContext().setStream(level, stream);
 }
 
-SimpleLogger::SimpleLogger(const std::string & tag)
-  : m_impl(std::make_unique<SimpleLogger::Impl>(tag))
+void SimpleLogger::addSink(SinkPtr sink)
 {
+    defaultContext().addSink(std::move(sink));
 }
 
-void SimpleLogger::initialize(std::string filename, bool append)
+void SimpleLogger::addSink(SinkPtr sink, const SinkOptions & options)
 {
-    Impl::initialize(filename, append);
+    defaultContext().addSink(std::move(sink), options);
 }
 
-void SimpleLogger::enableEchoMode(bool enable)
+void SimpleLogger::removeSink(const SinkPtr & sink)
 {
-    Impl::enableEchoMode(enable);
+    defaultContext().removeSink(sink);
 }
 
-void SimpleLogger::setLoggingLevel(Level level)
+void SimpleLogger::setTraceSink(SinkPtr sink)
 {
-    Impl::setLoggingLevel(level);
+    defaultContext().setTraceSink(std::move(sink));
 }
 
-void SimpleLogger::setLevelSymbol(Level level, std::string symbol)
+SimpleLogger::SinkPtr SimpleLogger::createTraceFileSink(std::string filename)
 {
-    Impl::setLevelSymbol(level, symbol);
+    return std::make_shared<TraceFileSink>(filename);
 }
 
-void SimpleLogger::setTimestampMode(TimestampMode timestampMode)
+SimpleLogger::SinkPtr SimpleLogger::createFileSink(std::string filename, bool append)
 {
-    Impl::setTimestampMode(timestampMode);
+    return std::make_shared<FileSink>(filename, append);
 }
 
-void SimpleLogger::setCustomTimestampFormat(std::string customTimestampFormat)
+SimpleLogger::SinkPtr SimpleLogger::createCompressedFileSink(std::string filename, bool append, int compressionLevel, std::chrono::milliseconds flushInterval)
 {
-    Impl::setTimestampMode(TimestampMode::Custom);
-    Impl::setCustomTimestampFormat(customTimestampFormat);
+#ifdef SIMPLE_LOGGER_HAVE_ZLIB
+    return std::make_shared<CompressedFileSink>(filename, append, compressionLevel, flushInterval);
+#else
+    (void)filename;
+    (void)append;
+    (void)compressionLevel;
+    (void)flushInterval;
+    throw std::runtime_error("ERROR!!: Compressed file sink requires SimpleLogger to be built with zlib.\n");
+#endif
 }
 
-void SimpleLogger::setTimestampSeparator(std::string timestampSeparator)
+SimpleLogger::SinkPtr SimpleLogger::createUnixSocketSink(std::string path, SocketType type, size_t spillCapacity)
 {
-    Impl::setTimestampSeparator(timestampSeparator);
+#ifndef _WIN32
+    return std::make_shared<UnixSocketSink>(path, type, spillCapacity);
+#else
+    (void)path;
+    (void)type;
+    (void)spillCapacity;
+    throw std::runtime_error("ERROR!!: Unix domain socket sink is not supported on this platform.\n");
+#endif
 }
 
-void SimpleLogger::setBatchInterval(std::chrono::milliseconds interval)
+SimpleLogger::SharedMemoryCollectorPtr SimpleLogger::createSharedMemoryCollector(std::string name, size_t capacity, SinkPtr sink)
 {
-    Impl::setBatchInterval(interval);
+#ifndef _WIN32
+    return SharedMemoryCollectorPtr { new SharedMemoryCollector { std::make_unique<SharedMemoryCollector::Impl>(name, capacity, std::move(sink)) } };
+#else
+    (void)name;
+    (void)capacity;
+    (void)sink;
+    throw std::runtime_error("ERROR!!: Shared memory logging is not supported on this platform.\n");
+#endif
 }
 
-void SimpleLogger::setCollapseRepeatedMessages(bool collapse)
+SimpleLogger::SinkPtr SimpleLogger::createSharedMemorySink(std::string name, SinkOptions::Overflow overflow)
 {
-    Impl::setCollapseRepeatedMessages(collapse);
+#ifndef _WIN32
+    return std::make_shared<SharedMemorySink>(name, overflow);
+#else
+    (void)name;
+    (void)overflow;
+    throw std::runtime_error("ERROR!!: Shared memory logging is not supported on this platform.\n");
+#endif
 }
 
-void SimpleLogger::flush()
+SimpleLogger::SinkPtr SimpleLogger::createBlockFileSink(std::string filename, bool append, size_t blockSize, std::chrono::milliseconds blockInterval)
 {
-    Impl::flush();
+    return std::make_shared<BlockFileSink>(filename, append, blockSize, blockInterval);
 }
 
-void SimpleLogger::setStream(Level level, std::ostream & stream)
+size_t SimpleLogger::queryBlockFile(const std::string & filename, const BlockFileQuery & query, const std::function<void(const Record &)> & callback)
+{
+    std::ifstream file { filename, std::ios::binary };
+    if (!file.is_open()) {
+        throw std::runtime_error("ERROR!!: Couldn't open '" + filename + "' for read.\n");
+    }
+
+    uint32_t levelMask = 0;
+    for (auto level = static_cast<unsigned int>(query.level); level < static_cast<unsigned int>(Level::None); level++) {
+        levelMask |= 1u << level;
+    }
+
+    size_t blocksRead = 0;
+    std::string payload;
+    for (auto && block : BlockFile::readBlocks(filename, file)) {
+        if (!(block.header.levels & levelMask) || BlockFile::fromMicroseconds(block.header.lastTime) < query.from || BlockFile::fromMicroseconds(block.header.firstTime) > query.to) {
+            continue;
+        }
+
+        payload.resize(block.header.payloadSize);
+        file.seekg(static_cast<std::streamoff>(block.offset + BlockFile::HeaderSize));
+        if (!file.read(payload.data(), static_cast<std::streamsize>(payload.size()))) {
+            break;
+        }
+        blocksRead++;
+
+        const char * data = payload.data();
+        const char * const end = data + payload.size();
+        for (uint32_t i = 0; i < block.header.recordCount && static_cast<size_t>(end - data) >= BlockFile::RecordHeaderSize; i++) {
+            const auto time = BlockFile::fromMicroseconds(BlockFile::get<int64_t>(data));
+            const auto level = static_cast<Level>(BlockFile::get<uint8_t>(data));
+            const auto size = BlockFile::get<uint32_t>(data);
+            if (size > static_cast<size_t>(end - data) || level >= Level::None) {
+                // Corrupted block
+                break;
+            }
+            if (level >= query.level && time >= query.from && time <= query.to) {
+                callback({ level, { data, size }, time });
+            }
+            data += size;
+        }
+    }
+
+    return blocksRead;
+}
+
+SimpleLogger::SinkPtr SimpleLogger::createConsoleSink()
+{
+    return std::make_shared<ConsoleSink>();
+}
+
+SimpleLogger::SinkPtr SimpleLogger::createStreamSink()
+{
+    return std::make_shared<StreamSink>();
+}
+
+SimpleLogger::SinkPtr SimpleLogger::createStreamSink(std::ostream & stream)
 {
-    Impl::setStream(level, stream);
+    return std::make_shared<StreamSink>(stream);
 }
 
-std::ostringstream & SimpleLogger::trace()
+void SimpleLogger::commit()
 {
-    return m_impl->traceStream();
+    auto && thread = currentThread();
+    m_message.write(thread.fieldsText.data(), thread.fieldsText.size());
+    auto && context = *m_context->m_impl;
+    std::lock_guard<ContextMutex> lock { context.mutex() };
+    context.output({ context.clockTicks(), thread.id, thread.name, m_location, m_level, m_tag, m_message.view() });
 }
 
-std::ostringstream & SimpleLogger::debug()
+SimpleLogger::ScopedContext::ScopedContext(std::initializer_list<Field> fields)
 {
-    return m_impl->debugStream();
+    auto && thread = currentThread();
+    m_previousSize = thread.fields.size();
+    thread.fields.insert(thread.fields.end(), fields.begin(), fields.end());
+    renderFields(thread);
 }
 
-std::ostringstream & SimpleLogger::info()
+SimpleLogger::ScopedContext::~ScopedContext()
 {
-    return m_impl->infoStream();
+    auto && thread = currentThread();
+    thread.fields.erase(thread.fields.begin() + static_cast<std::ptrdiff_t>(m_previousSize), thread.fields.end());
+    renderFields(thread);
 }
 
-std::ostringstream & SimpleLogger::warning()
+SimpleLogger::Span SimpleLogger::span(std::string name, Level level)
 {
-    return m_impl->warningStream();
+    Span span;
+    if (!isCompiledIn(level)) {
+        return span;
+    }
+    if (!m_context) {
+        m_context = &defaultContext();
+    }
+    if (m_context->isLevelEnabled(level)) {
+        // Contexts not owned by a ContextPtr, like the default context, are referred to without ownership
+        span.m_context = m_context->weak_from_this().lock();
+        if (!span.m_context) {
+            span.m_context = ContextPtr { ContextPtr {}, m_context };
+        }
+        span.m_name = std::move(name);
+        span.m_tag = std::string { m_tag };
+        span.m_location = m_location;
+        span.m_level = level;
+        span.m_start = m_context->m_impl->spanStart();
+    }
+    return span;
+}
+
+void SimpleLogger::endSpan(Span & span)
+{
+    span.m_context->m_impl->endSpan(span.m_name, span.m_tag, span.m_location, span.m_level, span.m_start);
+}
+
+SimpleLogger::Span::Span(Span && other) noexcept
+  : m_context { std::move(other.m_context) }
+  , m_name { std::move(other.m_name) }
+  , m_tag { std::move(other.m_tag) }
+  , m_location { other.m_location }
+  , m_level { other.m_level }
+  , m_start { other.m_start }
+{
+}
+
+SimpleLogger::Span::~Span()
+{
+    end();
+}
+
+void SimpleLogger::Span::end()
+{
+    if (m_context) {
+        endSpan(*this);
+        m_context.reset();
+    }
+}
+
+void SimpleLogger::commitProfiled()
+{
+    const auto bytes = m_message.view().size();
+    if (m_enabled) {
+        commit();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_profileStart);
+    thread_local ThreadCallSites callSites;
+    callSites.table().add(m_location, m_enabled, bytes, static_cast<uint64_t>(elapsed.count()));
+}
+
+void SimpleLogger::enableProfiling(bool enable, bool reportAtExit)
+{
+    s_profiling = enable;
+    if (reportAtExit) {
+        static const bool registered = [] {
+            profileRegistry(); // Created before the handler is registered
+            return std::atexit(&writeProfileReportAtExit) == 0;
+        }();
+        (void)registered;
+    }
 }
 
-std::ostringstream & SimpleLogger::error()
+std::vector<SimpleLogger::CallSiteStats> SimpleLogger::profile()
 {
-    return m_impl->errorStream();
+    auto && registry = profileRegistry();
+    std::lock_guard<std::mutex> lock { registry.mutex };
+    auto stats = registry.retired;
+    for (auto && table : registry.tables) {
+        mergeCallSites(*table, stats);
+    }
+
+    std::vector<CallSiteStats> sites;
+    sites.reserve(stats.size());
+    for (auto && site : stats) {
+        sites.push_back(site.second);
+    }
+    std::stable_sort(sites.begin(), sites.end(), [](auto && a, auto && b) {
+        return std::tie(a.emittedBytes, a.emitted, a.filtered) > std::tie(b.emittedBytes, b.emitted, b.filtered);
+    });
+    return sites;
 }
 
-std::ostringstream & SimpleLogger::fatal()
+void SimpleLogger::writeProfileReport(std::ostream & out)
 {
-    return m_impl->fatalStream();
+    const auto sites = profile();
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::setw(12) << "emitted" << std::setw(14) << "bytes" << std::setw(12) << "filtered" << std::setw(12) << "time (ms)"
+        << "  call site\n";
+    for (auto && site : sites) {
+        const auto milliseconds = std::chrono::duration<double, std::milli>(site.time).count();
+        out << std::setw(12) << site.emitted << std::setw(14) << site.emittedBytes << std::setw(12) << site.filtered
+            << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds << "  " << site.location.file;
+        if (site.location.line) {
+            out << ':' << site.location.line;
+        }
+        if (site.location.function) {
+            out << ' ' << site.location.function << "()";
+        }
+        out << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out.flush();
 }
 
 std::string SimpleLogger::version()
@@ -549,6 +4316,4 @@ std::string SimpleLogger::version()
     return "2.1.0";
 }
 
-SimpleLogger::~SimpleLogger() = default;
-
 } // juzzlin
@@ -25,9 +25,29 @@
 #ifndef JUZZLIN_SIMPLE_LOGGER_HPP
 #define JUZZLIN_SIMPLE_LOGGER_HPP
 
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <initializer_list>
 #include <memory>
-#include <sstream>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! Messages below this level (0 = Trace .. 5 = Fatal) are compiled out, e.g. -DSIMPLE_LOGGER_MIN_LEVEL=2
+//! removes trace() and debug() messages completely regardless of the runtime logging level.
+#ifndef SIMPLE_LOGGER_MIN_LEVEL
+#define SIMPLE_LOGGER_MIN_LEVEL 0
+#endif
 
 namespace juzzlin {
 
@@ -45,6 +65,16 @@ namespace juzzlin {
  */
 class SimpleLogger
 {
+    template<typename T, typename = void>
+    struct IsStreamable : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())>> : std::true_type
+    {
+    };
+
 public:
     enum class Level
     {
@@ -69,15 +99,779 @@ public:
         Custom
     };
 
+    enum class ClockSource
+    {
+        //! std::chrono::system_clock
+        SystemClock,
+
+        //! CLOCK_REALTIME_COARSE where available (Linux), otherwise SystemClock.
+        //! Cheaper to read, but has only the resolution of the kernel tick.
+        RealtimeCoarse,
+
+        //! Time stamp counter calibrated against and periodically resynced to the wall clock
+        //! where available (x86), otherwise SystemClock.
+        Tsc
+    };
+
+    //! Handling of line breaks in messages.
+    enum class MultiLineMode
+    {
+        //! Written as is. Only the first line has the prefix.
+        Keep,
+
+        //! Every line has the prefix, i.e. what the layout outputs before the message.
+        Prefix,
+
+        //! Continuation lines are indented to the width of the prefix.
+        Indent,
+
+        //! Line breaks and other control characters except tab are escaped as \n, \r or \xHH.
+        Escape
+    };
+
+    enum class SocketType
+    {
+        //! SOCK_STREAM. Records are framed as "LENGTH SP TEXT" (octet counting of RFC 6587).
+        Stream,
+
+        //! SOCK_DGRAM. One record per datagram.
+        Datagram
+    };
+
+    //! A rendered log line handed to sinks.
+    struct Record
+    {
+        //! Level of the message.
+        Level level;
+
+        //! The rendered line without the trailing newline.
+        std::string_view text;
+
+        //! Time of the message.
+        std::chrono::system_clock::time_point time;
+    };
+
+    /*!
+     * Base class for log outputs. Records are passed in batches: one record per call
+     * in the unbatched mode and the whole batch queue when a batch is flushed.
+     * A sink is called from one thread at a time.
+     */
+    class Sink
+    {
+    public:
+        //! Destructor.
+        virtual ~Sink();
+
+        //! Write records. An exception thrown by write() or flush() isn't propagated to the
+        //! logging code. It's reported to std::cerr once until the sink succeeds again.
+        //! \param records The records. The views are valid only during the call.
+        virtual void write(const std::vector<Record> & records) = 0;
+
+        //! Flush buffered output. Called after each write.
+        virtual void flush();
+    };
+
+    using SinkPtr = std::shared_ptr<Sink>;
+
+    //! Settings of a registered sink.
+    struct SinkOptions
+    {
+        enum class Overflow
+        {
+            Block,
+            Drop
+        };
+
+        //! The minimum level written to the sink.
+        Level level = Level::Trace;
+
+        //! Write from a dedicated worker thread with its own queue if true.
+        bool async = false;
+
+        //! Maximum number of records queued for an asynchronous sink.
+        size_t queueCapacity = 8192;
+
+        //! What to do when the queue of an asynchronous sink is full.
+        Overflow overflow = Overflow::Drop;
+    };
+
+    /*!
+     * Owner of a shared memory ring created with createSharedMemoryCollector(). Its thread writes the
+     * records pushed by the processes that log with createSharedMemorySink() to a sink. The ring is
+     * drained and removed when the collector is destroyed in the process that created it.
+     */
+    class SharedMemoryCollector
+    {
+    public:
+        //! Destructor.
+        ~SharedMemoryCollector();
+
+    private:
+        SharedMemoryCollector(const SharedMemoryCollector &) = delete;
+        SharedMemoryCollector & operator=(const SharedMemoryCollector &) = delete;
+
+        friend class SimpleLogger;
+
+        class Impl;
+
+        explicit SharedMemoryCollector(std::unique_ptr<Impl> impl);
+
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    using SharedMemoryCollectorPtr = std::shared_ptr<SharedMemoryCollector>;
+
+    //! Criteria of queryBlockFile().
+    struct BlockFileQuery
+    {
+        //! Earliest time of the records.
+        std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min();
+
+        //! Latest time of the records.
+        std::chrono::system_clock::time_point to = std::chrono::system_clock::time_point::max();
+
+        //! The minimum level of the records.
+        Level level = Level::Trace;
+    };
+
+    //! Settings of adaptive batching. \see SimpleLogger::setAdaptiveBatching()
+    struct AdaptiveBatching
+    {
+        //! Batch adaptively if true. Replaces the batch intervals of all levels.
+        bool enabled = false;
+
+        //! Batch interval at a low message rate.
+        std::chrono::milliseconds minInterval = std::chrono::milliseconds(1);
+
+        //! Batch interval at a high message rate. A message arriving this long after the previous one
+        //! is written immediately.
+        std::chrono::milliseconds maxInterval = std::chrono::milliseconds(100);
+
+        //! A batch is flushed once its messages take this many bytes.
+        size_t maxBytes = 1024 * 1024;
+
+        //! A batch is flushed once it has this many messages.
+        size_t maxEntries = 10000;
+    };
+
+    //! Settings used when creating an independent logging context.
+    struct Config
+    {
+        //! Log to filename. Disabled if empty.
+        std::string filename;
+
+        //! The existing log will be appended if true.
+        bool append = false;
+
+        //! Echo everything if true.
+        bool echoMode = true;
+
+        //! Echo directly to the stdout/stderr file descriptors if true.
+        bool fastEchoMode = false;
+
+        //! The minimum level.
+        Level level = Level::Info;
+
+        //! Timestamp mode enumeration.
+        TimestampMode timestampMode = TimestampMode::DateTime;
+
+        //! Timestamp format used with TimestampMode::Custom.
+        std::string customTimestampFormat;
+
+        //! Separator string outputted after timestamp.
+        std::string timestampSeparator = ": ";
+
+        //! Clock used to timestamp messages.
+        ClockSource clockSource = ClockSource::SystemClock;
+
+        //! Output pattern. The default layout is used if empty.
+        std::string pattern;
+
+        //! Handling of line breaks in messages.
+        MultiLineMode multiLineMode = MultiLineMode::Keep;
+
+        //! The batch interval. 0 to disable.
+        std::chrono::milliseconds batchInterval = std::chrono::milliseconds(0);
+
+        //! Collapse repeated messages in a batch if true.
+        bool collapseRepeatedMessages = false;
+
+        //! Adaptive batching. Used instead of batchInterval if enabled.
+        AdaptiveBatching adaptiveBatching;
+
+        //! Memory resource of the batch queue. std::pmr::get_default_resource() if null.
+        //! Must outlive the context.
+        std::pmr::memory_resource * batchMemoryResource = nullptr;
+
+        //! Threads rendering large batches. \see SimpleLogger::setRenderThreads()
+        size_t renderThreads = 0;
+    };
+
+    /*!
+     * Logging context that owns its own output file, streams, lock, level and batch queue.
+     * The static API of SimpleLogger operates on the default context.
+     *
+     * Example:
+     *
+     * L::Config config;
+     * config.filename = "audit.log";
+     * auto audit = L::createContext(config);
+     *
+     * L(audit, "audit").info() << "User logged in";
+     */
+    class Context : public std::enable_shared_from_this<Context>
+    {
+    public:
+        //! Constructor. Uses default settings.
+        Context();
+
+        //! Constructor.
+        //! \param config Initial settings. Throws if the log file cannot be opened.
+        explicit Context(const Config & config);
+
+        //! Destructor. Flushes the batch queue.
+        ~Context();
+
+        //! \see SimpleLogger::initialize()
+        void initialize(std::string filename, bool append = false);
+
+        //! \see SimpleLogger::enableEchoMode()
+        void enableEchoMode(bool enable);
+
+        //! \see SimpleLogger::enableFastEchoMode()
+        void enableFastEchoMode(bool enable);
+
+        //! \see SimpleLogger::setLoggingLevel()
+        void setLoggingLevel(Level level);
+
+        //! \see SimpleLogger::setLevelSymbol()
+        void setLevelSymbol(Level level, std::string symbol);
+
+        //! \see SimpleLogger::setTimestampMode()
+        void setTimestampMode(TimestampMode timestampMode);
+
+        //! \see SimpleLogger::setCustomTimestampFormat()
+        void setCustomTimestampFormat(std::string customTimestampFormat);
+
+        //! \see SimpleLogger::setTimestampSeparator()
+        void setTimestampSeparator(std::string separator);
+
+        //! \see SimpleLogger::setMultiLineMode()
+        void setMultiLineMode(MultiLineMode multiLineMode);
+
+        //! \see SimpleLogger::setPattern()
+        void setPattern(std::string pattern);
+
+        //! \see SimpleLogger::setClockSource()
+        void setClockSource(ClockSource clockSource);
+
+        //! \see SimpleLogger::setBatchInterval()
+        void setBatchInterval(std::chrono::milliseconds interval);
+
+        //! \see SimpleLogger::setBatchInterval()
+        void setBatchInterval(Level level, std::chrono::milliseconds interval);
+
+        //! \see SimpleLogger::setAdaptiveBatching()
+        void setAdaptiveBatching(const AdaptiveBatching & settings);
+
+        //! \see SimpleLogger::flush()
+        void flush();
+
+        //! \see SimpleLogger::flushAsync()
+        std::future<void> flushAsync();
+
+        //! \see SimpleLogger::setCollapseRepeatedMessages()
+        void setCollapseRepeatedMessages(bool collapse);
+
+        //! \see SimpleLogger::setCollapseRepeatedMessages()
+        void setCollapseRepeatedMessages(Level level, bool collapse);
+
+        //! \see SimpleLogger::setRenderThreads()
+        void setRenderThreads(size_t threads);
+
+        //! \see SimpleLogger::setStream()
+        void setStream(Level level, std::ostream & stream);
+
+        //! \see SimpleLogger::addSink()
+        void addSink(SinkPtr sink);
+
+        //! \see SimpleLogger::addSink()
+        void addSink(SinkPtr sink, const SinkOptions & options);
+
+        //! \see SimpleLogger::removeSink()
+        void removeSink(const SinkPtr & sink);
+
+        //! \see SimpleLogger::setTraceSink()
+        void setTraceSink(SinkPtr sink);
+
+    private:
+        Context(const Context &) = delete;
+        Context & operator=(const Context &) = delete;
+
+        friend class SimpleLogger;
+
+        bool isLevelEnabled(Level level) const
+        {
+            return level >= m_level.load(std::memory_order_relaxed);
+        }
+
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+
+        std::atomic<Level> m_level;
+    };
+
+    using ContextPtr = std::shared_ptr<Context>;
+
+    /*!
+     * Message builder returned by trace()..fatal(). Messages up to 256 bytes are built in an
+     * inline buffer, longer ones in a reusable thread-local buffer. Arithmetic types are formatted
+     * with std::to_chars. Other types and manipulators go through their std::ostream operators.
+     */
+    class LogStream
+    {
+    public:
+        //! Constructor.
+        LogStream() = default;
+
+        //! Destructor.
+        ~LogStream()
+        {
+            if (m_buffer || m_formatter) {
+                release();
+            }
+        }
+
+        LogStream & operator<<(std::string_view value)
+        {
+            if (m_discard) {
+                return *this;
+            }
+            if (hasCustomFormatting()) {
+                formatter() << value;
+                return *this;
+            }
+            write(value.data(), value.size());
+            return *this;
+        }
+
+        LogStream & operator<<(const char * value)
+        {
+            if (value) {
+                *this << std::string_view { value };
+            }
+            return *this;
+        }
+
+        LogStream & operator<<(char value)
+        {
+            if (m_discard) {
+                return *this;
+            }
+            if (hasCustomFormatting()) {
+                formatter() << value;
+                return *this;
+            }
+            write(&value, 1);
+            return *this;
+        }
+
+        LogStream & operator<<(signed char value)
+        {
+            return *this << static_cast<char>(value);
+        }
+
+        LogStream & operator<<(unsigned char value)
+        {
+            return *this << static_cast<char>(value);
+        }
+
+        LogStream & operator<<(bool value)
+        {
+            if (m_discard) {
+                return *this;
+            }
+            if (hasCustomFormatting()) {
+                formatter() << value;
+                return *this;
+            }
+            return *this << (value ? '1' : '0');
+        }
+
+        template<typename T>
+        std::enable_if_t<std::is_arithmetic_v<T>, LogStream &> operator<<(T value)
+        {
+            if (m_discard) {
+                return *this;
+            }
+            if (hasCustomFormatting()) {
+                formatter() << value;
+                return *this;
+            }
+
+            reserve(m_size + MaxNumberLength);
+            std::to_chars_result result;
+            if constexpr (std::is_floating_point_v<T>) {
+                // Same as the default formatting of std::ostream
+                result = std::to_chars(m_data + m_size, m_data + m_capacity, value, std::chars_format::general, 6);
+            } else {
+                result = std::to_chars(m_data + m_size, m_data + m_capacity, value);
+            }
+            m_size = static_cast<size_t>(result.ptr - m_data);
+            return *this;
+        }
+
+        template<typename T>
+        std::enable_if_t<!std::is_arithmetic_v<T> && !std::is_convertible_v<const T &, std::string_view> && IsStreamable<T>::value, LogStream &> operator<<(const T & value)
+        {
+            if (!m_discard) {
+                formatter() << value;
+            }
+            return *this;
+        }
+
+        LogStream & operator<<(std::ostream & (*manipulator)(std::ostream &));
+
+        LogStream & operator<<(std::ios_base & (*manipulator)(std::ios_base &))
+        {
+            if (!m_discard) {
+                formatter() << manipulator;
+            }
+            return *this;
+        }
+
+        //! \return The message built so far.
+        std::string_view view() const
+        {
+            return { m_data, m_size };
+        }
+
+        //! \return True if nothing has been written.
+        bool empty() const
+        {
+            return !m_size;
+        }
+
+        //! Append raw characters.
+        void write(const char * data, size_t size)
+        {
+            // An empty view may have a null data pointer, which memcpy doesn't accept
+            if (m_discard || !size) {
+                return;
+            }
+            reserve(m_size + size);
+            std::memcpy(m_data + m_size, data, size);
+            m_size += size;
+        }
+
+    private:
+        LogStream(const LogStream &) = delete;
+        LogStream & operator=(const LogStream &) = delete;
+
+        friend class SimpleLogger;
+
+        static constexpr size_t InlineCapacity = 256;
+
+        static constexpr size_t MaxNumberLength = 64;
+
+        class Formatter;
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > m_capacity) {
+                grow(capacity);
+            }
+        }
+
+        void grow(size_t capacity);
+
+        void release();
+
+        std::ostream & formatter();
+
+        bool hasCustomFormatting() const
+        {
+            return m_formatter && isFormatterCustomized();
+        }
+
+        bool isFormatterCustomized() const;
+
+        char * m_data = m_inline.data();
+
+        size_t m_size = 0;
+
+        size_t m_capacity = InlineCapacity;
+
+        std::string * m_buffer = nullptr;
+
+        Formatter * m_formatter = nullptr;
+
+        //! Set when the level of the message is disabled. Everything written is ignored.
+        bool m_discard = false;
+
+        std::array<char, InlineCapacity> m_inline;
+    };
+
+    //! Location of a log statement. Use SIMPLE_LOGGER_HERE to capture the current location.
+    //! Only static strings are referenced, nothing is copied.
+    struct SourceLocation
+    {
+        //! Basename of the source file.
+        const char * file = nullptr;
+
+        //! Line number.
+        unsigned int line = 0;
+
+        //! Function name.
+        const char * function = nullptr;
+
+        //! \return Offset of the basename in the given path.
+        static constexpr size_t basenameOffset(const char * path)
+        {
+            size_t offset = 0;
+            for (size_t i = 0; path[i]; i++) {
+                if (path[i] == '/' || path[i] == '\\') {
+                    offset = i + 1;
+                }
+            }
+            return offset;
+        }
+    };
+
+    //! Counters of a log statement collected in the profiling mode. \see enableProfiling()
+    struct CallSiteStats
+    {
+        //! Location of the statement. The file is "?" for messages logged without a location.
+        SourceLocation location;
+
+        //! Messages written.
+        uint64_t emitted = 0;
+
+        //! Bytes of the written messages, excluding the timestamp, level and tag.
+        uint64_t emittedBytes = 0;
+
+        //! Messages filtered by the level. These are not formatted, so their size is not known.
+        uint64_t filtered = 0;
+
+        //! Time spent in the statement, from trace()..fatal() until the message has been passed to
+        //! the sinks.
+        std::chrono::nanoseconds time {};
+    };
+
+    /*!
+     * Times a scope with the clock of the context. Returned by span(). When the span ends, it's
+     * written as a Chrome trace event to the trace sink of the context, or as a log message with the
+     * duration if there's no trace sink.
+     *
+     * Example:
+     *
+     * {
+     *     auto span = L("db").span("query");
+     *     ...
+     * } // "db: query took 1.234 ms", or {"name":"query","cat":"db","ph":"X",...}
+     */
+    class Span
+    {
+    public:
+        //! Constructor. An inactive span.
+        Span() = default;
+
+        //! Move constructor. The other span becomes inactive.
+        Span(Span && other) noexcept;
+
+        //! Destructor. Ends the span.
+        ~Span();
+
+        //! End the span now. Does nothing if ended already.
+        void end();
+
+    private:
+        Span(const Span &) = delete;
+        Span & operator=(const Span &) = delete;
+        Span & operator=(Span &&) = delete;
+
+        friend class SimpleLogger;
+
+        //! Keeps the context alive until the span ends.
+        std::shared_ptr<Context> m_context;
+
+        std::string m_name;
+
+        std::string m_tag;
+
+        SourceLocation m_location;
+
+        Level m_level = Level::Info;
+
+        std::chrono::system_clock::time_point m_start;
+    };
+
+    /*!
+     * Mapped diagnostic context of the current thread. The fields are appended to every message the
+     * thread logs while the scoped context exists, e.g. "I: Order accepted {req=42, user=7}". The
+     * fields are rendered once when the context changes, and a queued message keeps the fields that
+     * were active when it was logged. Scoped contexts nest, and an inner field overrides an outer field
+     * with the same key. Must be destroyed on the thread that created it, in reverse order of creation.
+     *
+     * Example:
+     *
+     * L::ScopedContext request { { "req", requestId }, { "user", userName } };
+     * L().info() << "Order accepted"; // "I: Order accepted {req=42, user=alice}"
+     */
+    class ScopedContext
+    {
+    public:
+        //! A key-value pair of the context.
+        struct Field
+        {
+            //! Constructor.
+            Field(std::string key, std::string value)
+              : key { std::move(key) }
+              , value { std::move(value) }
+            {
+            }
+
+            //! Constructor. The value is converted with std::to_string().
+            template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+            Field(std::string key, T value)
+              : key { std::move(key) }
+              , value { std::to_string(value) }
+            {
+            }
+
+            std::string key;
+
+            std::string value;
+        };
+
+        //! Constructor. Adds the fields to the context of the current thread.
+        ScopedContext(std::initializer_list<Field> fields);
+
+        //! Destructor. Removes the fields from the context of the current thread.
+        ~ScopedContext();
+
+    private:
+        ScopedContext(const ScopedContext &) = delete;
+        ScopedContext & operator=(const ScopedContext &) = delete;
+
+        //! Number of fields of the enclosing contexts.
+        size_t m_previousSize;
+    };
+
+    // The constructors, the level check and the message buffer are inline so that disabled
+    // messages cost only a relaxed load and a branch, or nothing if below SIMPLE_LOGGER_MIN_LEVEL.
+    // Only commit() of an enabled message is out-of-line.
+
+    //! Tag of a message. A string literal is referred to, other strings are copied.
+    class Tag
+    {
+    public:
+        //! Constructor.
+        Tag()
+        {
+        }
+
+        //! Constructor.
+        //! \param text String literal, which lives until the end of the program.
+        template<size_t N>
+        Tag(const char (&text)[N])
+          : m_text { text }
+          , m_literal { true }
+        {
+        }
+
+        //! Constructor.
+        //! \param text Character buffer to copy.
+        template<size_t N>
+        Tag(char (&text)[N])
+          : m_text { text }
+        {
+        }
+
+        //! Constructor.
+        //! \param text String to copy, e.g. std::string or const char *.
+        template<typename T, typename = std::enable_if_t<!std::is_array_v<T> && std::is_convertible_v<const T &, std::string_view>>>
+        Tag(const T & text)
+          : m_text { text }
+        {
+        }
+
+    private:
+        friend class SimpleLogger;
+
+        std::string_view m_text;
+
+        bool m_literal = false;
+    };
+
+    //! Constructor.
+    SimpleLogger()
+    {
+    }
+
+    //! Constructor.
+    //! \param tag Tag that will be added to the message.
+    SimpleLogger(Tag tag)
+      : m_tag { keep(tag) }
+    {
+    }
+
+    //! Constructor.
+    //! \param context The context the message will be logged to.
+    //! \param tag Tag that will be added to the message.
+    SimpleLogger(const ContextPtr & context, Tag tag = {})
+      : m_context { context.get() }
+      , m_tag { keep(tag) }
+    {
+    }
+
     //! Constructor.
-    SimpleLogger();
+    //! \param location Source location, e.g. SIMPLE_LOGGER_HERE.
+    //! \param tag Tag that will be added to the message.
+    SimpleLogger(const SourceLocation & location, Tag tag = {})
+      : m_tag { keep(tag) }
+      , m_location { location }
+    {
+    }
 
     //! Constructor.
+    //! \param context The context the message will be logged to.
+    //! \param location Source location, e.g. SIMPLE_LOGGER_HERE.
     //! \param tag Tag that will be added to the message.
-    SimpleLogger(const std::string & tag);
+    SimpleLogger(const ContextPtr & context, const SourceLocation & location, Tag tag = {})
+      : m_context { context.get() }
+      , m_tag { keep(tag) }
+      , m_location { location }
+    {
+    }
+
+    //! Destructor. Writes the message if its level is enabled.
+    ~SimpleLogger()
+    {
+        if (m_profiled) {
+            commitProfiled();
+        } else if (m_enabled) {
+            commit();
+        }
+    }
 
-    //! Destructor.
-    ~SimpleLogger();
+    //! Create an independent logging context with default settings.
+    //! \return The new context.
+    static ContextPtr createContext();
+
+    //! Create an independent logging context.
+    //! \param config Initial settings of the context.
+    //! \return The new context. Throws on error.
+    static ContextPtr createContext(const Config & config);
+
+    //! \return The context used by the static API and by loggers constructed without a context.
+    static Context & defaultContext()
+    {
+        if (const auto context = s_defaultContext.load(std::memory_order_acquire)) {
+            return *context;
+        }
+        return createDefaultContext();
+    }
 
     /*! Initialize the logger.
      *  \param filename Log to filename. Disabled if empty.
@@ -89,6 +883,11 @@ public:
     //! \param enable Echo everything if true. Default is false.
     static void enableEchoMode(bool enable);
 
+    //! Enable/disable fast echo mode. Echoed messages are then buffered and written with write(2)
+    //! directly to stdout (Trace..Info) and stderr (Warning..Fatal) instead of the streams set with setStream().
+    //! \param enable Write to the file descriptors if true. Default is false.
+    static void enableFastEchoMode(bool enable);
+
     //! Set the logging level.
     //! \param level The minimum level. Default is Info.
     static void setLoggingLevel(Level level);
@@ -110,53 +909,348 @@ public:
     //! \param separator Separator string outputted after timestamp.
     static void setTimestampSeparator(std::string separator);
 
-    //! Set the batch interval.
+    //! Set the handling of line breaks in messages, e.g. for line-oriented log parsers. A trailing
+    //! newline is dropped in the Prefix and Indent modes. Messages without control characters cost
+    //! only a vectorized scan.
+    //! \param multiLineMode Multi-line mode enumeration. Default is MultiLineMode::Keep.
+    static void setMultiLineMode(MultiLineMode multiLineMode);
+
+    /*! Set the layout of the output lines. The pattern is compiled once. Conversions:
+     *  %d         Timestamp in the current timestamp mode (without the separator)
+     *  %d{FORMAT} Timestamp in the given mode: DATETIME, ISO, ISO_MS, EPOCH_S, EPOCH_MS, EPOCH_US,
+     *             or a custom strftime() format e.g. %d{%H:%M:%S}
+     *  %l         Level symbol
+     *  %T         Tag
+     *  %t         Thread id
+     *  %N         Thread name set with setThreadName()
+     *  %F         Source file, if logged with a SourceLocation
+     *  %L         Source line, if logged with a SourceLocation
+     *  %M         Function name, if logged with a SourceLocation
+     *  %m         Message
+     *  %n         Newline
+     *  %%         Percent sign
+     *  Example: L::setPattern("%d{ISO_MS} [%l] %t %T: %m");
+     *  \param pattern The pattern. Empty restores the default layout. */
+    static void setPattern(std::string pattern);
+
+    //! Set the name of the calling thread. Rendered with %N in the output pattern.
+    //! \param name The name.
+    static void setThreadName(std::string name);
+
+    //! Set the clock source. Only a raw tick is captured when a message is logged. It's converted
+    //! to the timestamp when the message is written, i.e. at flush in the batch mode.
+    //! Flushes the batch queue.
+    //! \param clockSource The clock source. Default is SystemClock.
+    static void setClockSource(ClockSource clockSource);
+
+    //! Set the batch interval of all levels.
     //! \param interval The interval in milliseconds. 0 to disable.
     static void setBatchInterval(std::chrono::milliseconds interval);
 
+    //! Set the batch interval of the given level. The batch is flushed by a background thread when
+    //! the oldest message of any level has waited for the interval of its level. A message logged
+    //! after a pause of its interval is written immediately. A message of an unbatched level flushes
+    //! the pending batch before it, so the order of messages is kept.
+    //! Example: L::setBatchInterval(L::Level::Error, 0ms); L::setBatchInterval(L::Level::Fatal, 0ms);
+    //! \param level The level.
+    //! \param interval The interval in milliseconds. 0 writes the messages immediately.
+    static void setBatchInterval(Level level, std::chrono::milliseconds interval);
+
     //! Flush the batch queue.
     static void flush();
 
-    //! Enable/disable collapsing of repeated messages.
+    //! Flush the batch queue on a background thread. Concurrent requests share one flush.
+    //! \return Future that becomes ready once everything logged before the call has been written
+    //! to the sinks, including the asynchronous ones. Errors of the sinks are reported by the
+    //! sinks and don't fail the future. \see Sink::write()
+    static std::future<void> flushAsync();
+
+    //! Write the queued messages of all contexts, including those queued for asynchronous sinks,
+    //! and disable batching, so that messages logged afterwards are written immediately.
+    //! Queued messages are also written automatically at normal process exit.
+    //! \param deadline Time to stop waiting for the asynchronous sinks.
+    //! \return True if everything was written before the deadline.
+    static bool shutdown(std::chrono::steady_clock::time_point deadline);
+
+    //! Enable/disable flushing of the batch queues when the process receives SIGABRT, SIGBUS, SIGFPE,
+    //! SIGILL, SIGSEGV or SIGTERM. The signal is then re-raised with the default handling. This is
+    //! best effort: flushing is not async-signal-safe, and a context that is locked is skipped.
+    //! Asynchronous sinks are not waited for.
+    //! \param enable Install the handlers if true, restore the previous ones if false. Default is false.
+    static void enableEmergencyFlush(bool enable);
+
+    //! Set the sink the spans are written to as Chrome trace events, e.g. createTraceFileSink().
+    //! Spans are written as log messages if not set.
+    //! \param sink The trace sink, or nullptr to remove it.
+    static void setTraceSink(SinkPtr sink);
+
+    //! Create a sink that writes records containing trace events to a file in the Chrome trace event
+    //! JSON format, viewable in chrome://tracing and Perfetto. The file is completed when the sink is
+    //! destroyed.
+    //! \param filename The file name.
+    //! \return The sink. Throws if the file cannot be opened.
+    static SinkPtr createTraceFileSink(std::string filename);
+
+    //! Enable/disable profiling of log statements. The messages emitted and filtered, their bytes and
+    //! the time spent are counted per call site (file and line), so only messages logged with a
+    //! SourceLocation (SIMPLE_LOGGER_HERE) are told apart. The counters are kept in per-thread tables
+    //! without locks. Messages below SIMPLE_LOGGER_MIN_LEVEL are not counted.
+    //! \param enable Count if true. Default is false.
+    //! \param reportAtExit Write profileReport() to std::cerr at normal process exit if true.
+    static void enableProfiling(bool enable, bool reportAtExit = false);
+
+    //! \return Counters of the profiled call sites, the most emitted bytes first.
+    static std::vector<CallSiteStats> profile();
+
+    //! Write the counters of the profiled call sites as a table, the most emitted bytes first.
+    //! \param out The output stream.
+    static void writeProfileReport(std::ostream & out);
+
+    /*!
+     * Set adaptive batching, which adjusts the batch interval to the message rate. Messages are written
+     * immediately at a low rate. As the rate rises, the interval grows from minInterval to
+     * maxInterval, reaching it when maxEntries messages would arrive within maxInterval. A batch is
+     * flushed early once it reaches maxEntries or maxBytes. A background thread flushes a batch when
+     * its interval expires, so a message waits at most maxInterval.
+     * \param settings The settings. Adaptive batching is disabled if settings.enabled is false.
+     */
+    static void setAdaptiveBatching(const AdaptiveBatching & settings);
+
+    //! Enable/disable collapsing of repeated messages of all levels.
     //! \param collapse If true, repeated messages in a batch will be collapsed.
     static void setCollapseRepeatedMessages(bool collapse);
 
+    //! Enable/disable collapsing of repeated messages of the given level.
+    //! \param level The level.
+    //! \param collapse If true, repeated messages of the level in a batch will be collapsed.
+    static void setCollapseRepeatedMessages(Level level, bool collapse);
+
+    //! Set the number of threads rendering a large batch in parallel when it's flushed, including the
+    //! flushing thread. The lines are written in order. The worker threads are started on the first
+    //! large batch.
+    //! \param threads 0 to use up to four threads depending on the hardware, 1 to render on the
+    //! flushing thread only. Default is 0.
+    static void setRenderThreads(size_t threads);
+
     //! Set specific stream.
     //! \param level The level.
     //! \param stream The output stream.
     static void setStream(Level level, std::ostream & stream);
 
+    //! Add an output to the default context. Log file and echo mode remain as they are.
+    //! \param sink The sink.
+    static void addSink(SinkPtr sink);
+
+    //! Add an output to the default context.
+    //! \param sink The sink.
+    //! \param options Level filter and threading of the sink.
+    static void addSink(SinkPtr sink, const SinkOptions & options);
+
+    //! Remove a sink from the default context. Queued records of an asynchronous sink are written first.
+    //! \param sink The sink.
+    static void removeSink(const SinkPtr & sink);
+
+    //! Create a sink that writes to a file.
+    //! \param filename The file name.
+    //! \param append The existing file will be appended if true.
+    //! \return The sink. Throws on error.
+    static SinkPtr createFileSink(std::string filename, bool append = false);
+
+    //! Create a sink that writes a gzip compressed file. The sink compresses on its own thread. The
+    //! records are collected into independently decodable gzip members of 64 KiB of input, or less
+    //! if the oldest record of a member has waited for the flush interval.
+    //! \param filename The file name.
+    //! \param append The existing file will be appended if true.
+    //! \param compressionLevel zlib compression level 0..9.
+    //! \param flushInterval The longest time a record waits before it's written to the file.
+    //! \return The sink. Throws on error or if the library has been built without zlib.
+    static SinkPtr createCompressedFileSink(std::string filename, bool append = false, int compressionLevel = 6, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(1000));
+
+    //! Create a sink that writes records in blocks. Each block has a header with the time range,
+    //! a bitmap of the levels and the number of records, and it's listed in the index file
+    //! <filename>.idx, so that queryBlockFile() can skip non-matching blocks. A flush writes the
+    //! block once it has reached the block size or has been open for the block interval. The last
+    //! block is written when the sink is destroyed.
+    //! \param filename The file name.
+    //! \param append The existing file will be appended if true. Throws if it isn't a block file.
+    //! \param blockSize Payload size that closes a block, up to 1 MiB.
+    //! \param blockInterval Time after which the next flush closes a block.
+    //! \return The sink. Throws on error.
+    static SinkPtr createBlockFileSink(std::string filename, bool append = false, size_t blockSize = 64 * 1024, std::chrono::milliseconds blockInterval = std::chrono::milliseconds(1000));
+
+    //! Create a sink that sends records to a local collector over a Unix domain socket. Records of a
+    //! batch are sent with as few system calls as possible (sendmsg() with an iovec per record, or
+    //! sendmmsg() for datagrams). The socket is non-blocking: records that can't be sent are kept in a
+    //! spill buffer and sent later, and the connection is retried while the collector is unavailable.
+    //! When the spill buffer is full, the oldest records are dropped and reported after reconnecting.
+    //! \param path Path of the socket of the collector.
+    //! \param type Stream or datagram socket.
+    //! \param spillCapacity Maximum number of bytes kept while the collector can't receive.
+    //! \return The sink. Throws on error or if Unix domain sockets are not supported.
+    static SinkPtr createUnixSocketSink(std::string path, SocketType type = SocketType::Stream, size_t spillCapacity = 1024 * 1024);
+
+    //! Create a shared memory ring (shm_open) and a collector thread that writes the records pushed to
+    //! the ring by any process to the given sink, in the order they were pushed. Typically created by a
+    //! parent process before forking workers that log with createSharedMemorySink().
+    //! \param name Name of the shared memory object, e.g. "/myapp-log".
+    //! \param capacity Size of the ring in bytes. Rounded up to a power of two. Messages longer than
+    //! an eighth of the ring are truncated.
+    //! \param sink The sink the records are written to.
+    //! \return The collector. Throws if the shared memory object exists or cannot be created.
+    static SharedMemoryCollectorPtr createSharedMemoryCollector(std::string name, size_t capacity, SinkPtr sink);
+
+    //! Create a sink that pushes records to the shared memory ring of a collector without locks.
+    //! A producer that dies in the middle of a push stalls the collector.
+    //! \param name Name of the shared memory object.
+    //! \param overflow Wait for the collector or drop the record when the ring is full. Dropped
+    //! records are reported by the collector.
+    //! \return The sink. Throws if the ring cannot be opened.
+    static SinkPtr createSharedMemorySink(std::string name, SinkOptions::Overflow overflow = SinkOptions::Overflow::Drop);
+
+    //! Read records from a file written by a block file sink.
+    //! \param filename The file name.
+    //! \param query Time range and the minimum level of the records.
+    //! \param callback Called for each matching record in the order they were written.
+    //! \return The number of blocks read, i.e. not skipped. Throws if the file cannot be opened.
+    static size_t queryBlockFile(const std::string & filename, const BlockFileQuery & query, const std::function<void(const Record &)> & callback);
+
+    //! Create a sink that writes Trace..Info to the stdout and Warning..Fatal to the stderr file descriptor.
+    //! Output is buffered per batch and written with as few system calls as possible.
+    static SinkPtr createConsoleSink();
+
+    //! Create a sink that writes Trace..Info to std::cout and Warning..Fatal to std::cerr.
+    static SinkPtr createStreamSink();
+
+    //! Create a sink that writes to the given stream.
+    //! \param stream The output stream.
+    static SinkPtr createStreamSink(std::ostream & stream);
+
     //! \return Library version in x.y.z
     static std::string version();
 
+    //! Start timing a scope. The tag is the category of the trace event. \see Span
+    //! \param name Name of the span.
+    //! \param level Level of the span. The span is inactive if the level isn't enabled.
+    //! \return The span. Ends when destroyed.
+    Span span(std::string name, Level level = Level::Info);
+
     //! Get stream to the trace log message.
-    std::ostringstream & trace();
+    LogStream & trace()
+    {
+        return select(Level::Trace);
+    }
 
     //! Get stream to the debug log message.
-    std::ostringstream & debug();
+    LogStream & debug()
+    {
+        return select(Level::Debug);
+    }
 
     //! Get stream to the info log message.
-    std::ostringstream & info();
+    LogStream & info()
+    {
+        return select(Level::Info);
+    }
 
     //! Get stream to the warning log message.
-    std::ostringstream & warning();
+    LogStream & warning()
+    {
+        return select(Level::Warning);
+    }
 
     //! Get stream to the error log message.
-    std::ostringstream & error();
+    LogStream & error()
+    {
+        return select(Level::Error);
+    }
 
     //! Get stream to the fatal log message.
-    std::ostringstream & fatal();
+    LogStream & fatal()
+    {
+        return select(Level::Fatal);
+    }
 
 private:
     SimpleLogger(const SimpleLogger &) = delete;
     SimpleLogger & operator=(const SimpleLogger &) = delete;
 
-    class Impl;
-    std::unique_ptr<Impl> m_impl;
+    static constexpr bool isCompiledIn(Level level)
+    {
+        return static_cast<int>(level) >= SIMPLE_LOGGER_MIN_LEVEL;
+    }
+
+    std::string_view keep(const Tag & tag)
+    {
+        if (tag.m_literal || tag.m_text.empty()) {
+            return tag.m_text;
+        }
+        m_ownedTag = tag.m_text;
+        return m_ownedTag;
+    }
+
+    LogStream & select(Level level)
+    {
+        m_level = level;
+        m_enabled = false;
+        if (isCompiledIn(level)) {
+            if (!m_context) {
+                m_context = &defaultContext();
+            }
+            m_enabled = m_context->isLevelEnabled(level);
+            if (s_profiling.load(std::memory_order_relaxed)) {
+                m_profiled = true;
+                m_profileStart = std::chrono::steady_clock::now();
+            }
+        }
+        m_message.m_discard = !m_enabled;
+        return m_message;
+    }
+
+    //! Timestamp the message and pass it to the context.
+    void commit();
+
+    //! Commit if enabled and count the message to its call site.
+    void commitProfiled();
+
+    //! Write the span to its context.
+    static void endSpan(Span & span);
+
+    static inline std::atomic<bool> s_profiling { false };
+
+    static Context & createDefaultContext();
+
+    static inline std::atomic<Context *> s_defaultContext { nullptr };
+
+    Context * m_context = nullptr;
+
+    //! Copy of a tag that isn't a string literal.
+    std::string m_ownedTag;
+
+    std::string_view m_tag;
+
+    SourceLocation m_location;
+
+    Level m_level = Level::Info;
+
+    bool m_enabled = false;
+
+    bool m_profiled = false;
+
+    std::chrono::steady_clock::time_point m_profileStart;
+
+    LogStream m_message;
 };
 
 using L = SimpleLogger;
 
 } // namespace juzzlin
 
+//! Source location of the current line, e.g. L(SIMPLE_LOGGER_HERE).info() << "Hello";
+//! The basename of the file is computed at compile time.
+#define SIMPLE_LOGGER_HERE                                                                                                             \
+    ::juzzlin::SimpleLogger::SourceLocation                                                                                            \
+    {                                                                                                                                  \
+        __FILE__ + std::integral_constant<size_t, ::juzzlin::SimpleLogger::SourceLocation::basenameOffset(__FILE__)>::value, __LINE__, __func__ \
+    }
+
 #endif // JUZZLIN_SIMPLE_LOGGER_HPP
@@ -0,0 +1,329 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Allocations made by the calling thread
+static thread_local size_t allocationCount = 0;
+
+void * operator new(size_t size)
+{
+    allocationCount++;
+    if (void * p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc {};
+}
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void * p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace juzzlin::AllocTest {
+
+//! Discards everything. Keeps the cost of the sinks out of the measurements.
+class NullSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> &) override
+    {
+    }
+};
+
+L::ContextPtr createContext()
+{
+    L::Config config;
+    config.echoMode = false;
+    const auto context = L::createContext(config);
+    context->addSink(std::make_shared<NullSink>());
+    return context;
+}
+
+void logCanonicalMessage(const L::ContextPtr & context)
+{
+    L(context).info() << 42 << " items in " << std::string_view { "queue" };
+}
+
+//! \return Allocations per call of the given function after warming up.
+template<typename Function>
+double allocationsPerCall(Function && function, size_t calls = 1000)
+{
+    for (size_t i = 0; i < 10; i++) {
+        function();
+    }
+    const auto before = allocationCount;
+    for (size_t i = 0; i < calls; i++) {
+        function();
+    }
+    return static_cast<double>(allocationCount - before) / static_cast<double>(calls);
+}
+
+void testFilteredMessage_shouldNotAllocate()
+{
+    const auto context = createContext();
+    context->setLoggingLevel(L::Level::Warning);
+
+    assert(allocationsPerCall([&] { logCanonicalMessage(context); }) == 0);
+    assert(allocationsPerCall([&] { L(context, "tag").debug() << "A message longer than the small string buffer " << 1.5; }) == 0);
+    assert(allocationsPerCall([&] { L(context, "A tag longer than the small string buffer").debug() << "Message"; }) == 0);
+}
+
+void testEmittedMessage_shouldNotAllocateInAnyTimestampMode()
+{
+    const auto context = createContext();
+    for (auto && mode : { L::TimestampMode::None, L::TimestampMode::DateTime, L::TimestampMode::EpochSeconds,
+                          L::TimestampMode::EpochMilliseconds, L::TimestampMode::EpochMicroseconds, L::TimestampMode::ISODateTime,
+                          L::TimestampMode::ISODateTimeMilliseconds }) {
+        context->setTimestampMode(mode);
+        assert(allocationsPerCall([&] { logCanonicalMessage(context); }) == 0);
+    }
+    context->setCustomTimestampFormat("%H:%M:%S");
+    assert(allocationsPerCall([&] { logCanonicalMessage(context); }) == 0);
+}
+
+void testBatchedMessage_shouldNotAllocateAfterFirstBatch()
+{
+    const auto context = createContext();
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+    const auto batch = [&] {
+        for (size_t i = 0; i < 100; i++) {
+            logCanonicalMessage(context);
+        }
+        context->flush();
+    };
+    assert(allocationsPerCall(batch, 10) == 0);
+
+    // One index node per distinct message
+    context->setCollapseRepeatedMessages(true);
+    assert(allocationsPerCall(batch, 10) <= 1);
+}
+
+//! Counts the records written on the worker thread.
+class CountingSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        written += records.size();
+    }
+
+    std::atomic<size_t> written { 0 };
+};
+
+void testAsyncSinks_shouldShareOneCopyOfRecords()
+{
+    L::Config config;
+    config.echoMode = false;
+    const auto context = L::createContext(config);
+    L::SinkOptions options;
+    options.async = true;
+    std::vector<std::shared_ptr<CountingSink>> sinks;
+    for (size_t i = 0; i < 4; i++) {
+        sinks.push_back(std::make_shared<CountingSink>());
+        context->addSink(sinks.back(), options);
+    }
+
+    size_t logged = 0;
+    const auto logAndWait = [&] {
+        logCanonicalMessage(context);
+        logged++;
+        for (auto && sink : sinks) {
+            while (sink->written < logged) {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    // The copies are reused once the workers have released them
+    assert(allocationsPerCall(logAndWait) < 0.1);
+}
+
+//! Counts the bytes allocated from the upstream resource.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocated = 0;
+
+private:
+    void * do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+void testBatchMemoryResource_shouldBeUsedAndReusedAfterFlush()
+{
+    CountingResource resource;
+    {
+        L::Config config;
+        config.echoMode = false;
+        config.batchInterval = std::chrono::milliseconds(60000);
+        config.batchMemoryResource = &resource;
+        const auto context = L::createContext(config);
+        context->addSink(std::make_shared<NullSink>());
+
+        const std::string message(1000, 'x');
+        for (size_t i = 0; i < 1000; i++) {
+            L(context).info() << message;
+        }
+        context->flush();
+        const auto allocated = resource.allocated;
+        assert(allocated >= 1000 * message.size());
+
+        for (size_t i = 0; i < 1000; i++) {
+            L(context).info() << message;
+        }
+        context->flush();
+        assert(resource.allocated == allocated);
+    }
+}
+
+#ifdef __linux__
+
+//! \return Retired instructions per call, or 0 if perf events are not available.
+template<typename Function>
+uint64_t instructionsPerCall(Function && function, size_t calls = 1000)
+{
+    perf_event_attr attributes {};
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    const auto fd = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    if (fd < 0) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < 10; i++) {
+        function();
+    }
+    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    for (size_t i = 0; i < calls; i++) {
+        function();
+    }
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t count = 0;
+    if (::read(fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+    }
+    ::close(fd);
+    return count / calls;
+}
+
+void testInstructionCounts_shouldBeReported()
+{
+    const auto context = createContext();
+    context->setTimestampMode(L::TimestampMode::ISODateTimeMilliseconds);
+    const auto emitted = instructionsPerCall([&] { logCanonicalMessage(context); });
+    if (!emitted) {
+        std::cout << "Instruction counts not available (perf_event_open failed)" << std::endl;
+        return;
+    }
+    context->setLoggingLevel(L::Level::Warning);
+    const auto filtered = instructionsPerCall([&] { logCanonicalMessage(context); });
+    std::cout << "Instructions per emitted message: " << emitted << std::endl;
+    std::cout << "Instructions per filtered message: " << filtered << std::endl;
+    assert(filtered < emitted);
+}
+
+#endif
+
+} // namespace juzzlin::AllocTest
+
+int main()
+{
+    juzzlin::AllocTest::testFilteredMessage_shouldNotAllocate();
+
+    juzzlin::AllocTest::testEmittedMessage_shouldNotAllocateInAnyTimestampMode();
+
+    juzzlin::AllocTest::testBatchedMessage_shouldNotAllocateAfterFirstBatch();
+
+    juzzlin::AllocTest::testBatchMemoryResource_shouldBeUsedAndReusedAfterFlush();
+
+    juzzlin::AllocTest::testAsyncSinks_shouldShareOneCopyOfRecords();
+
+#ifdef __linux__
+    juzzlin::AllocTest::testInstructionCounts_shouldBeReported();
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::BlockFileTest {
+
+const std::string fileName = "block_file_test.slb";
+
+std::vector<std::string> query(const L::BlockFileQuery & query, size_t expectedBlocksRead)
+{
+    std::vector<std::string> lines;
+    const auto blocksRead = L::queryBlockFile(fileName, query, [&lines](const L::Record & record) {
+        lines.emplace_back(record.text);
+    });
+    assert(blocksRead == expectedBlocksRead);
+    return lines;
+}
+
+L::ContextPtr createContext(bool append)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.level = L::Level::Trace;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+    // Every flush closes a block
+    context->addSink(L::createBlockFileSink(fileName, append, 0));
+    return context;
+}
+
+void testQuery_shouldSkipBlocksNotMatchingLevelOrTime()
+{
+    std::chrono::system_clock::time_point secondBatchStart;
+    {
+        const auto context = createContext(false);
+        L(context).debug() << "Debug 1";
+        L(context).info() << "Info 1";
+        context->flush();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        secondBatchStart = std::chrono::system_clock::now();
+
+        L(context).debug() << "Debug 2";
+        L(context).error() << "Error 2";
+        context->flush();
+
+        L(context).trace() << "Trace 3";
+        context->flush();
+    }
+
+    assert(query({}, 3) == std::vector<std::string>({ "D: Debug 1", "I: Info 1", "D: Debug 2", "E: Error 2", "T: Trace 3" }));
+
+    L::BlockFileQuery errors;
+    errors.level = L::Level::Error;
+    assert(query(errors, 1) == std::vector<std::string>({ "E: Error 2" }));
+
+    L::BlockFileQuery recent;
+    recent.from = secondBatchStart;
+    assert(query(recent, 2) == std::vector<std::string>({ "D: Debug 2", "E: Error 2", "T: Trace 3" }));
+
+    L::BlockFileQuery old;
+    old.to = secondBatchStart - std::chrono::milliseconds(1);
+    old.level = L::Level::Info;
+    assert(query(old, 1) == std::vector<std::string>({ "I: Info 1" }));
+}
+
+void testMissingIndex_shouldBeRebuiltByScanning()
+{
+    std::remove((fileName + ".idx").c_str());
+    assert(query({}, 3).size() == 5);
+}
+
+void testTruncatedBlock_shouldBeDroppedWhenAppending()
+{
+    // Simulate a crash in the middle of writing a block
+    {
+        std::ofstream file { fileName, std::ios::binary | std::ios::app };
+        file << "SLB1garbage";
+    }
+    assert(query({}, 3).size() == 5);
+
+    {
+        const auto context = createContext(true);
+        L(context).warning() << "Appended";
+    }
+
+    const auto lines = query({}, 4);
+    assert(lines.size() == 6);
+    assert(lines.back() == "W: Appended");
+}
+
+void testUnbatchedMessages_shouldShareBlocks()
+{
+    {
+        L::Config config;
+        config.echoMode = false;
+        config.timestampMode = L::TimestampMode::None;
+        const auto context = L::createContext(config);
+        // Only the size may close a block, however slowly the messages are written
+        context->addSink(L::createBlockFileSink(fileName, false, 64 * 1024, std::chrono::milliseconds(60000)));
+        for (int i = 0; i < 1000; i++) {
+            L(context).info() << "Message " << i;
+        }
+    }
+
+    const auto lines = query({}, 1);
+    assert(lines.size() == 1000);
+    assert(lines.back() == "I: Message 999");
+}
+
+void testAppendingToOtherFile_shouldThrowAndKeepFile()
+{
+    const std::string otherFileName = "block_file_test_other.log";
+    {
+        std::ofstream file { otherFileName, std::ios::binary | std::ios::trunc };
+        file << "I: Plain text log\n";
+    }
+
+    bool thrown = false;
+    try {
+        L::createBlockFileSink(otherFileName, true);
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::ifstream file { otherFileName, std::ios::binary };
+    std::string content;
+    std::getline(file, content);
+    assert(content == "I: Plain text log");
+}
+
+void testCorruptedRecordSize_shouldStopReadingBlock()
+{
+    {
+        const auto context = createContext(false);
+        L(context).info() << "Message";
+        context->flush();
+    }
+
+    // Size field of the first record
+    {
+        std::fstream file { fileName, std::ios::binary | std::ios::in | std::ios::out };
+        file.seekp(36 + 8 + 1);
+        file.write("\xf0\xff\xff\xff", 4);
+    }
+
+    assert(query({}, 1).empty());
+}
+
+} // namespace juzzlin::BlockFileTest
+
+int main()
+{
+    juzzlin::BlockFileTest::testQuery_shouldSkipBlocksNotMatchingLevelOrTime();
+
+    juzzlin::BlockFileTest::testMissingIndex_shouldBeRebuiltByScanning();
+
+    juzzlin::BlockFileTest::testTruncatedBlock_shouldBeDroppedWhenAppending();
+
+    juzzlin::BlockFileTest::testUnbatchedMessages_shouldShareBlocks();
+
+    juzzlin::BlockFileTest::testAppendingToOtherFile_shouldThrowAndKeepFile();
+
+    juzzlin::BlockFileTest::testCorruptedRecordSize_shouldStopReadingBlock();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace juzzlin::ClockTest {
+
+int64_t epochMilliseconds()
+{
+    using std::chrono::duration_cast;
+    return duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void testBatchedMessage_shouldHaveTimestampOfLoggingTime(L::ClockSource clockSource)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::EpochMilliseconds;
+    config.timestampSeparator = " ";
+    config.clockSource = clockSource;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+    std::stringstream ss;
+    context->addSink(L::createStreamSink(ss));
+
+    const auto before = epochMilliseconds();
+    L(context).info() << "Message";
+    const auto after = epochMilliseconds();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    context->flush();
+
+    // Allow some slack for the coarse clock and for the calibration of the time stamp counter
+    const auto timestamp = std::stoll(ss.str());
+    assert(timestamp >= before - 50);
+    assert(timestamp <= after + 50);
+    assert(ss.str().find(" I: Message") != std::string::npos);
+}
+
+} // namespace juzzlin::ClockTest
+
+int main()
+{
+    juzzlin::ClockTest::testBatchedMessage_shouldHaveTimestampOfLoggingTime(juzzlin::L::ClockSource::SystemClock);
+
+    juzzlin::ClockTest::testBatchedMessage_shouldHaveTimestampOfLoggingTime(juzzlin::L::ClockSource::RealtimeCoarse);
+
+    juzzlin::ClockTest::testBatchedMessage_shouldHaveTimestampOfLoggingTime(juzzlin::L::ClockSource::Tsc);
+
+    return EXIT_SUCCESS;
+}
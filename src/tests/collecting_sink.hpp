@@ -0,0 +1,89 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef JUZZLIN_COLLECTING_SINK_HPP
+#define JUZZLIN_COLLECTING_SINK_HPP
+
+#include "../simple_logger.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::Test {
+
+//! Sink that keeps the written lines and the size of each write. Can be read while the logger
+//! writes from its worker or flusher thread.
+class CollectingSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_batches.push_back(records.size());
+        for (auto && record : records) {
+            m_lines.emplace_back(record.text);
+        }
+    }
+
+    std::vector<std::string> lines()
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_lines;
+    }
+
+    //! \return Number of records in each write.
+    std::vector<size_t> batches()
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        return m_batches;
+    }
+
+    //! Wait until count lines have been written.
+    //! \return False if that doesn't happen within five seconds.
+    bool waitForLines(size_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (lines().size() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+
+    std::vector<std::string> m_lines;
+
+    std::vector<size_t> m_batches;
+};
+
+} // namespace juzzlin::Test
+
+#endif // JUZZLIN_COLLECTING_SINK_HPP
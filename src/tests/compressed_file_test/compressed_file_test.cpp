@@ -0,0 +1,146 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <zlib.h>
+
+namespace juzzlin::CompressedFileTest {
+
+std::string decompressFile(const std::string & fileName)
+{
+    const auto file = gzopen(fileName.c_str(), "rb");
+    assert(file);
+
+    std::string result;
+    std::array<char, 4096> buffer;
+    int bytesRead = 0;
+    while ((bytesRead = gzread(file, buffer.data(), static_cast<unsigned int>(buffer.size()))) > 0) {
+        result.append(buffer.data(), static_cast<size_t>(bytesRead));
+    }
+    gzclose(file);
+
+    return result;
+}
+
+bool waitForContent(const std::string & fileName, const std::string & expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (decompressFile(fileName) != expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+L::ContextPtr createContext()
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    return L::createContext(config);
+}
+
+void testFlushedBatches_shouldBeDecodableWithinFlushInterval()
+{
+    const std::string fileName = "compressed_file_test.log.gz";
+    const auto context = createContext();
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+    context->addSink(L::createCompressedFileSink(fileName, false, 6, std::chrono::milliseconds(20)));
+
+    L(context).info() << "First batch";
+    context->flush();
+    assert(waitForContent(fileName, "I: First batch\n"));
+
+    L(context).info() << "Second batch";
+    L(context).info() << "Second batch";
+    context->flush();
+    assert(waitForContent(fileName, "I: First batch\nI: Second batch\nI: Second batch\n"));
+}
+
+void testUnbatchedMessages_shouldBeCompressedTogether()
+{
+    const std::string fileName = "compressed_file_test_unbatched.log.gz";
+    std::string expected;
+    {
+        const auto context = createContext();
+        context->addSink(L::createCompressedFileSink(fileName));
+        for (int i = 0; i < 5000; i++) {
+            L(context).info() << "Request " << i << " completed with status 200 in " << i % 97 << " ms";
+            expected += "I: Request " + std::to_string(i) + " completed with status 200 in " + std::to_string(i % 97) + " ms\n";
+        }
+    }
+
+    assert(decompressFile(fileName) == expected);
+    assert(std::filesystem::file_size(fileName) * 4 < expected.size());
+}
+
+void testAsyncSink_shouldWriteAllMessages()
+{
+    const std::string fileName = "compressed_file_test_async.log.gz";
+    const auto context = createContext();
+    auto sink = L::createCompressedFileSink(fileName);
+    L::SinkOptions options;
+    options.async = true;
+    options.overflow = L::SinkOptions::Overflow::Block;
+    context->addSink(sink, options);
+
+    std::string expected;
+    for (int i = 0; i < 1000; i++) {
+        L(context).info() << "Message " << i;
+        expected += "I: Message " + std::to_string(i) + "\n";
+    }
+    context->removeSink(sink);
+    sink.reset(); // Writes the last member
+
+    assert(decompressFile(fileName) == expected);
+}
+
+} // namespace juzzlin::CompressedFileTest
+
+int main()
+{
+    juzzlin::CompressedFileTest::testFlushedBatches_shouldBeDecodableWithinFlushInterval();
+
+    juzzlin::CompressedFileTest::testUnbatchedMessages_shouldBeCompressedTogether();
+
+    juzzlin::CompressedFileTest::testAsyncSink_shouldWriteAllMessages();
+
+    return EXIT_SUCCESS;
+}
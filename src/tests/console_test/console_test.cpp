@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace juzzlin::ConsoleTest {
+
+std::string readFile(const std::string & fileName)
+{
+    std::ifstream fin { fileName };
+    std::stringstream ss;
+    ss << fin.rdbuf();
+    return ss.str();
+}
+
+//! Redirects stdout and stderr to the same file for the lifetime of the object.
+class ConsoleCapture
+{
+public:
+    explicit ConsoleCapture(const std::string & fileName)
+      : m_stdout { dup(STDOUT_FILENO) }
+      , m_stderr { dup(STDERR_FILENO) }
+    {
+        const int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+
+    ~ConsoleCapture()
+    {
+        dup2(m_stdout, STDOUT_FILENO);
+        dup2(m_stderr, STDERR_FILENO);
+        close(m_stdout);
+        close(m_stderr);
+    }
+
+private:
+    int m_stdout;
+
+    int m_stderr;
+};
+
+void testFastEcho_shouldKeepOrderAcrossStdoutAndStderr()
+{
+    const std::string fileName = "console_test.log";
+    {
+        ConsoleCapture capture { fileName };
+
+        L::enableFastEchoMode(true);
+        L::setTimestampMode(L::TimestampMode::None);
+        L::setBatchInterval(std::chrono::milliseconds(60000));
+
+        L().info() << "First";
+        L().error() << "Second";
+        L().info() << "Third";
+        L().warning() << "Fourth";
+
+        L::flush();
+
+        L().info() << "Fifth";
+
+        L::setBatchInterval(std::chrono::milliseconds(0));
+
+        L().error() << "Sixth";
+    }
+
+    assert(readFile(fileName) == "I: First\nE: Second\nI: Third\nW: Fourth\nI: Fifth\nE: Sixth\n");
+}
+
+} // namespace juzzlin::ConsoleTest
+
+int main()
+{
+    juzzlin::ConsoleTest::testFastEcho_shouldKeepOrderAcrossStdoutAndStderr();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace juzzlin::ContextTest {
+
+std::string readFile(const std::string & fileName)
+{
+    std::ifstream fin { fileName };
+    std::stringstream ss;
+    ss << fin.rdbuf();
+    return ss.str();
+}
+
+void testTwoContexts_messagesShouldGoToOwnFiles()
+{
+    L::Config auditConfig;
+    auditConfig.filename = "context_test_audit.log";
+    auditConfig.echoMode = false;
+    auditConfig.timestampMode = L::TimestampMode::None;
+    const auto audit = L::createContext(auditConfig);
+
+    L::Config debugConfig;
+    debugConfig.filename = "context_test_debug.log";
+    debugConfig.echoMode = false;
+    debugConfig.level = L::Level::Debug;
+    debugConfig.timestampMode = L::TimestampMode::None;
+    const auto debug = L::createContext(debugConfig);
+
+    L(audit, "audit").info() << "User logged in";
+    L(debug).debug() << "Cache miss";
+    L(audit).debug() << "Filtered by audit level";
+
+    const auto auditLog = readFile(auditConfig.filename);
+    const auto debugLog = readFile(debugConfig.filename);
+
+    assert(auditLog == "I: audit: User logged in\n");
+    assert(debugLog == "D: Cache miss\n");
+}
+
+void testContextBatching_shouldNotAffectOtherContexts()
+{
+    L::Config config;
+    config.filename = "context_test_batch.log";
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto batched = L::createContext(config);
+
+    std::stringstream ss;
+    const auto immediate = L::createContext();
+    immediate->setStream(L::Level::Info, ss);
+    immediate->setTimestampMode(L::TimestampMode::None);
+
+    L(batched).info() << "Batched message";
+    L(immediate).info() << "Immediate message";
+
+    assert(readFile(config.filename).empty());
+    assert(ss.str() == "I: Immediate message\n");
+
+    batched->flush();
+    assert(readFile(config.filename) == "I: Batched message\n");
+}
+
+void testDefaultContext_shouldBeUsedByStaticApi()
+{
+    std::stringstream ss;
+    L::setStream(L::Level::Warning, ss);
+    L::setTimestampMode(L::TimestampMode::None);
+    L::defaultContext().setLevelSymbol(L::Level::Warning, "<W>");
+    L().warning() << "Default context";
+    assert(ss.str() == "<W> Default context\n");
+}
+
+void testTemporaryTag_shouldBeCopiedByLogger()
+{
+    std::stringstream ss;
+    const auto context = L::createContext();
+    context->setStream(L::Level::Info, ss);
+    context->setTimestampMode(L::TimestampMode::None);
+
+    const std::string prefix = "A tag longer than the small string buffer";
+    {
+        L logger { context, prefix + " of a temporary" };
+        const std::string overwrite(prefix.size() + 15, 'x');
+        logger.info() << "Message";
+    }
+
+    assert(ss.str() == "I: " + prefix + " of a temporary: Message\n");
+}
+
+} // namespace juzzlin::ContextTest
+
+int main()
+{
+    juzzlin::ContextTest::testTwoContexts_messagesShouldGoToOwnFiles();
+
+    juzzlin::ContextTest::testContextBatching_shouldNotAffectOtherContexts();
+
+    juzzlin::ContextTest::testDefaultContext_shouldBeUsedByStaticApi();
+
+    juzzlin::ContextTest::testTemporaryTag_shouldBeCopiedByLogger();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::DeliveryTest {
+
+using Test::CollectingSink;
+
+L::ContextPtr createContext(std::shared_ptr<L::Sink> sink)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.level = L::Level::Trace;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    return context;
+}
+
+void testUnbatchedLevel_shouldFlushPendingBatchBeforeIt()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    context->setBatchInterval(L::Level::Error, std::chrono::milliseconds(0));
+
+    L(context).info() << "A";
+    L(context).debug() << "B";
+    assert(sink->lines().empty());
+
+    L(context).error() << "C";
+    assert(sink->lines() == std::vector<std::string>({ "I: A", "D: B", "E: C" }));
+
+    L(context).info() << "D";
+    assert(sink->lines().size() == 3);
+}
+
+void testShortInterval_shouldFlushWholeBatchWhenExpired()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    context->setBatchInterval(L::Level::Warning, std::chrono::milliseconds(20));
+
+    L(context).info() << "A";
+    L(context).warning() << "W";
+    assert(sink->lines().empty());
+
+    assert(sink->waitForLines(2));
+    L(context).info() << "B";
+
+    assert(sink->lines() == std::vector<std::string>({ "I: A", "W: W" }));
+}
+
+void testPerLevelCollapse_shouldCollapseOnlyGivenLevel()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    context->setCollapseRepeatedMessages(L::Level::Info, true);
+
+    for (int i = 0; i < 3; i++) {
+        L(context).info() << "X";
+        L(context).warning() << "Y";
+    }
+    context->flush();
+
+    assert(sink->lines() == std::vector<std::string>({ "I: X (x3)", "W: Y", "W: Y", "W: Y" }));
+}
+
+std::vector<std::string> flushLargeBatch(size_t renderThreads)
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    context->setCollapseRepeatedMessages(L::Level::Debug, true);
+    context->setRenderThreads(renderThreads);
+
+    for (int i = 0; i < 10000; i++) {
+        L(context).info() << "Message " << i;
+        L(context).debug() << "Repeated";
+    }
+    context->flush();
+
+    return sink->lines();
+}
+
+void testParallelRendering_shouldKeepOrderOfLargeBatch()
+{
+    const auto lines = flushLargeBatch(4);
+
+    assert(lines.size() == 10001);
+    assert(lines.at(0) == "I: Message 0");
+    assert(lines.at(1) == "D: Repeated (x10000)");
+    for (size_t i = 2; i < lines.size(); i++) {
+        assert(lines.at(i) == "I: Message " + std::to_string(i - 1));
+    }
+
+    assert(lines == flushLargeBatch(1));
+    assert(lines == flushLargeBatch(3));
+}
+
+L::ContextPtr createAdaptiveContext(std::shared_ptr<CollectingSink> sink, const L::AdaptiveBatching & settings)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.adaptiveBatching = settings;
+    config.adaptiveBatching.enabled = true;
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    return context;
+}
+
+void testFixedInterval_loneMessage_shouldBeFlushedByTimer()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(50);
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+
+    const auto start = std::chrono::steady_clock::now();
+    L(context).info() << "Lone";
+    assert(sink->waitForLines(1));
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+void testAdaptiveBatching_lowRate_shouldWriteImmediately()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::AdaptiveBatching settings;
+    settings.maxInterval = std::chrono::milliseconds(20);
+    const auto context = createAdaptiveContext(sink, settings);
+
+    for (int i = 0; i < 3; i++) {
+        L(context).info() << "Idle " << i;
+        assert(sink->lines().size() == static_cast<size_t>(i + 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+}
+
+void testAdaptiveBatching_burst_shouldBatchUpToMaxEntriesAndFlushTailByTimer()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::AdaptiveBatching settings;
+    settings.maxInterval = std::chrono::milliseconds(200);
+    settings.maxEntries = 100;
+    const auto context = createAdaptiveContext(sink, settings);
+
+    for (int i = 0; i < 1050; i++) {
+        L(context).info() << "Burst " << i;
+    }
+    assert(sink->waitForLines(1050));
+
+    const auto lines = sink->lines();
+    for (size_t i = 0; i < lines.size(); i++) {
+        assert(lines.at(i) == "I: Burst " + std::to_string(i));
+    }
+    assert(sink->batches().size() < 100);
+    for (auto && size : sink->batches()) {
+        assert(size <= 100);
+    }
+}
+
+void testAdaptiveBatching_burst_shouldRespectMaxBytes()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::AdaptiveBatching settings;
+    settings.maxInterval = std::chrono::milliseconds(200);
+    settings.maxBytes = 1000;
+    const auto context = createAdaptiveContext(sink, settings);
+
+    const std::string message(100, 'x');
+    for (int i = 0; i < 200; i++) {
+        L(context).info() << message;
+    }
+    assert(sink->waitForLines(200));
+
+    assert(sink->batches().size() < 100);
+    for (auto && size : sink->batches()) {
+        assert(size <= 10);
+    }
+}
+
+} // namespace juzzlin::DeliveryTest
+
+int main()
+{
+    juzzlin::DeliveryTest::testUnbatchedLevel_shouldFlushPendingBatchBeforeIt();
+
+    juzzlin::DeliveryTest::testShortInterval_shouldFlushWholeBatchWhenExpired();
+
+    juzzlin::DeliveryTest::testPerLevelCollapse_shouldCollapseOnlyGivenLevel();
+
+    juzzlin::DeliveryTest::testParallelRendering_shouldKeepOrderOfLargeBatch();
+
+    juzzlin::DeliveryTest::testFixedInterval_loneMessage_shouldBeFlushedByTimer();
+
+    juzzlin::DeliveryTest::testAdaptiveBatching_lowRate_shouldWriteImmediately();
+
+    juzzlin::DeliveryTest::testAdaptiveBatching_burst_shouldBatchUpToMaxEntriesAndFlushTailByTimer();
+
+    juzzlin::DeliveryTest::testAdaptiveBatching_burst_shouldRespectMaxBytes();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::DiagnosticContextTest {
+
+using Test::CollectingSink;
+
+L::ContextPtr createContext(std::shared_ptr<L::Sink> sink, std::chrono::milliseconds batchInterval = std::chrono::milliseconds(0))
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = batchInterval;
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    return context;
+}
+
+void testScopedContext_shouldAppendFieldsWhileItExists()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+
+    L(context).info() << "Before";
+    {
+        L::ScopedContext request { { "req", 42 }, { "user", "alice" } };
+        L(context, "orders").info() << "Accepted";
+    }
+    L(context).info() << "After";
+
+    assert(sink->lines() == std::vector<std::string>({ "I: Before", "I: orders: Accepted {req=42, user=alice}", "I: After" }));
+}
+
+void testNestedContext_shouldOverrideAndRestoreFields()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+
+    L::ScopedContext outer { { "req", "1" }, { "shard", "eu" } };
+    {
+        L::ScopedContext inner { { "req", "2" } };
+        L(context).info() << "Inner";
+    }
+    L(context).info() << "Outer";
+
+    assert(sink->lines() == std::vector<std::string>({ "I: Inner {shard=eu, req=2}", "I: Outer {req=1, shard=eu}" }));
+}
+
+void testBatchedMessage_shouldKeepContextOfLogTime()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink, std::chrono::milliseconds(60000));
+
+    {
+        L::ScopedContext request { { "req", 7 } };
+        L(context).info() << "Queued";
+    }
+    L(context).info() << "Plain";
+    assert(sink->lines().empty());
+
+    context->flush();
+    assert(sink->lines() == std::vector<std::string>({ "I: Queued {req=7}", "I: Plain" }));
+}
+
+void testContext_shouldBeThreadLocal()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+
+    L::ScopedContext request { { "req", 1 } };
+    std::thread { [&context] {
+        L(context).info() << "Other";
+    } }.join();
+    L(context).info() << "Own";
+
+    assert(sink->lines() == std::vector<std::string>({ "I: Other", "I: Own {req=1}" }));
+}
+
+void testSpanWithTraceSink_shouldWriteFieldsAsArgs()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    std::stringstream trace;
+    context->setTraceSink(L::createStreamSink(trace));
+
+    {
+        L::ScopedContext request { { "req", 3 } };
+        L(context).span("query");
+    }
+    context->flush();
+
+    assert(trace.str().find(R"("args":{"req":"3"})") != std::string::npos);
+}
+
+} // namespace juzzlin::DiagnosticContextTest
+
+int main()
+{
+    juzzlin::DiagnosticContextTest::testScopedContext_shouldAppendFieldsWhileItExists();
+
+    juzzlin::DiagnosticContextTest::testNestedContext_shouldOverrideAndRestoreFields();
+
+    juzzlin::DiagnosticContextTest::testBatchedMessage_shouldKeepContextOfLogTime();
+
+    juzzlin::DiagnosticContextTest::testContext_shouldBeThreadLocal();
+
+    juzzlin::DiagnosticContextTest::testSpanWithTraceSink_shouldWriteFieldsAsArgs();
+
+    return EXIT_SUCCESS;
+}
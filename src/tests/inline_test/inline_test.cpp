@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+// Built with SIMPLE_LOGGER_MIN_LEVEL=2 (Info) and the sources compiled in via SimpleLogger_interface
+
+namespace juzzlin::InlineTest {
+
+L::ContextPtr createContext(std::ostringstream & stream)
+{
+    L::Config config;
+    config.level = L::Level::Trace;
+    config.timestampMode = L::TimestampMode::None;
+    const auto context = L::createContext(config);
+    context->setStream(L::Level::Trace, stream);
+    context->setStream(L::Level::Debug, stream);
+    context->setStream(L::Level::Info, stream);
+    context->setStream(L::Level::Warning, stream);
+    return context;
+}
+
+void testCompiledOutLevels_shouldNotBeLoggedEvenIfEnabledAtRuntime()
+{
+    std::ostringstream stream;
+    const auto context = createContext(stream);
+
+    L(context).trace() << "Trace";
+    L(context).debug() << "Debug";
+    L(context).info() << "Info";
+
+    assert(stream.str() == "I: Info\n");
+}
+
+void testDisabledLevel_streamShouldDiscardEverything()
+{
+    std::ostringstream stream;
+    const auto context = createContext(stream);
+    context->setLoggingLevel(L::Level::Warning);
+
+    L logger { context };
+    auto && message = logger.info();
+    message << "Disabled " << 42 << ' ' << 1.5 << std::endl;
+    assert(message.empty());
+
+    L(context).warning() << "Enabled " << 42;
+    assert(stream.str() == "W: Enabled 42\n");
+}
+
+} // namespace juzzlin::InlineTest
+
+int main()
+{
+    juzzlin::InlineTest::testCompiledOutLevels_shouldNotBeLoggedEvenIfEnabledAtRuntime();
+
+    juzzlin::InlineTest::testDisabledLevel_streamShouldDiscardEverything();
+
+    return EXIT_SUCCESS;
+}
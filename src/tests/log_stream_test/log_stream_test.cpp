@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace juzzlin::LogStreamTest {
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+std::ostream & operator<<(std::ostream & stream, const Point & point)
+{
+    return stream << "(" << point.x << ", " << point.y << ")";
+}
+
+struct Noisy
+{
+};
+
+std::ostream & operator<<(std::ostream & stream, const Noisy &)
+{
+    // Logging while another message is being built must not corrupt it
+    L().info() << "Nested " << std::string(1000, 'n');
+    return stream << "noisy";
+}
+
+std::string logged(const std::string & message)
+{
+    return "I: " + message + "\n";
+}
+
+void testArithmeticTypes_shouldBeFormattedLikeOstream(std::stringstream & ss)
+{
+    ss.str({});
+    L().info() << 42 << ' ' << -7L << ' ' << 123456789012ULL << ' ' << 3.14159265 << ' ' << 0.5f << ' ' << 1e20 << ' ' << true;
+    assert(ss.str() == logged("42 -7 123456789012 3.14159 0.5 1e+20 1"));
+}
+
+void testStrings_shouldBeAppended(std::stringstream & ss)
+{
+    ss.str({});
+    const std::string string = "string";
+    const std::string_view view = "view";
+    const char * nullString = nullptr;
+    L().info() << "literal " << string << ' ' << view << ' ' << 'c' << nullString << std::string_view {};
+    assert(ss.str() == logged("literal string view c"));
+}
+
+void testUserTypes_shouldUseOstreamOperator(std::stringstream & ss)
+{
+    ss.str({});
+    L().info() << "Point " << Point { 1, 2 } << " done";
+    assert(ss.str() == logged("Point (1, 2) done"));
+}
+
+void testManipulators_shouldBeApplied(std::stringstream & ss)
+{
+    ss.str({});
+    L().info() << std::hex << 255 << std::dec << ' ' << 255 << ' ' << std::setprecision(3) << 3.14159 << std::endl;
+    assert(ss.str() == logged("ff 255 3.14\n"));
+}
+
+void testWidthAndFill_shouldApplyToStringsAndCharacters(std::stringstream & ss)
+{
+    std::ostringstream expected;
+    expected << '[' << std::setw(6) << "ab" << "][" << std::setfill('*') << std::left << std::setw(4) << 'x' << "][" << std::setw(5) << std::string("cd") << std::right << "][" << std::setw(3) << std::string_view("e") << ']';
+
+    ss.str({});
+    L().info() << '[' << std::setw(6) << "ab" << "][" << std::setfill('*') << std::left << std::setw(4) << 'x' << "][" << std::setw(5) << std::string("cd") << std::right << "][" << std::setw(3) << std::string_view("e") << ']';
+    assert(expected.str() == "[    ab][x***][cd***][**e]");
+    assert(ss.str() == logged(expected.str()));
+}
+
+void testLongMessages_shouldNotBeTruncated(std::stringstream & ss)
+{
+    for (auto && length : { 255, 256, 257, 1000, 100000 }) {
+        ss.str({});
+        const std::string message(static_cast<size_t>(length), 'x');
+        L().info() << message.substr(0, 10) << message.substr(10);
+        assert(ss.str() == logged(message));
+    }
+}
+
+void testNestedLogging_shouldNotCorruptMessages(std::stringstream & ss)
+{
+    ss.str({});
+    const std::string longMessage(500, 'l');
+    L().info() << longMessage << Noisy {} << longMessage;
+    assert(ss.str() == logged("Nested " + std::string(1000, 'n')) + logged(longMessage + "noisy" + longMessage));
+}
+
+} // namespace juzzlin::LogStreamTest
+
+int main()
+{
+    using namespace juzzlin;
+
+    std::stringstream ss;
+    L::setStream(L::Level::Info, ss);
+    L::setTimestampMode(L::TimestampMode::None);
+
+    LogStreamTest::testArithmeticTypes_shouldBeFormattedLikeOstream(ss);
+
+    LogStreamTest::testStrings_shouldBeAppended(ss);
+
+    LogStreamTest::testUserTypes_shouldUseOstreamOperator(ss);
+
+    LogStreamTest::testManipulators_shouldBeApplied(ss);
+
+    LogStreamTest::testWidthAndFill_shouldApplyToStringsAndCharacters(ss);
+
+    LogStreamTest::testLongMessages_shouldNotBeTruncated(ss);
+
+    LogStreamTest::testNestedLogging_shouldNotCorruptMessages(ss);
+
+    return EXIT_SUCCESS;
+}
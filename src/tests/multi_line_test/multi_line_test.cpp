@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace juzzlin::MultiLineTest {
+
+using Test::CollectingSink;
+
+std::shared_ptr<CollectingSink> logWithMode(L::MultiLineMode mode, const std::string & message, const std::string & tag = {})
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.multiLineMode = mode;
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    L(context, tag).info() << message;
+    return sink;
+}
+
+std::string render(L::MultiLineMode mode, const std::string & message, const std::string & tag = {})
+{
+    const auto sink = logWithMode(mode, message, tag);
+    assert(sink->lines().size() == 1);
+    return sink->lines().at(0);
+}
+
+void testKeep_shouldWriteMessageAsIs()
+{
+    assert(render(L::MultiLineMode::Keep, "a\nb\n") == "I: a\nb\n");
+}
+
+void testPrefix_shouldPrefixEveryLine()
+{
+    assert(render(L::MultiLineMode::Prefix, "a\nb\n\nc\n") == "I: a\nI: b\nI: \nI: c");
+    assert(render(L::MultiLineMode::Prefix, "a\nb", "db") == "I: db: a\nI: db: b");
+}
+
+void testIndent_shouldIndentContinuationLines()
+{
+    assert(render(L::MultiLineMode::Indent, "a\nb", "db") == "I: db: a\n       b");
+}
+
+void testEscape_shouldEscapeControlCharacters()
+{
+    assert(render(L::MultiLineMode::Escape, "a\nb\r\x01\tc\x1f") == "I: a\\nb\\r\\x01\tc\\x1f");
+
+    // UTF-8 is not escaped
+    assert(render(L::MultiLineMode::Escape, "\xc3\xa4\x7f") == "I: \xc3\xa4\x7f");
+}
+
+void testLineBreakAtAnyPosition_shouldBeFound()
+{
+    // Covers the vector loops and the scalar tail
+    for (size_t length = 1; length < 80; length++) {
+        for (size_t position = 0; position < length; position++) {
+            std::string message(length, 'x');
+            message[position] = '\n';
+            auto expected = "I: " + message;
+            expected.replace(3 + position, 1, "\\n");
+            assert(render(L::MultiLineMode::Escape, message) == expected);
+
+            expected = "I: " + message;
+            if (position + 1 < length) {
+                expected.insert(3 + position + 1, "I: ");
+            } else {
+                expected.pop_back();
+            }
+            assert(render(L::MultiLineMode::Prefix, message) == expected);
+        }
+    }
+}
+
+void testCollapsedMultiLineMessage_shouldHaveCountAtEnd()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.multiLineMode = L::MultiLineMode::Prefix;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    config.collapseRepeatedMessages = true;
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+
+    L(context).warning() << "a\nb";
+    L(context).warning() << "a\nb";
+    context->flush();
+
+    assert(sink->lines() == std::vector<std::string>({ "W: a\nW: b (x2)" }));
+}
+
+} // namespace juzzlin::MultiLineTest
+
+int main()
+{
+    juzzlin::MultiLineTest::testKeep_shouldWriteMessageAsIs();
+
+    juzzlin::MultiLineTest::testPrefix_shouldPrefixEveryLine();
+
+    juzzlin::MultiLineTest::testIndent_shouldIndentContinuationLines();
+
+    juzzlin::MultiLineTest::testEscape_shouldEscapeControlCharacters();
+
+    juzzlin::MultiLineTest::testLineBreakAtAnyPosition_shouldBeFound();
+
+    juzzlin::MultiLineTest::testCollapsedMultiLineMessage_shouldHaveCountAtEnd();
+
+    return EXIT_SUCCESS;
+}
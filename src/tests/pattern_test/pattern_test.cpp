@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cstdlib>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace juzzlin::PatternTest {
+
+L::ContextPtr createContext(std::stringstream & ss, const std::string & pattern)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.pattern = pattern;
+    const auto context = L::createContext(config);
+    context->addSink(L::createStreamSink(ss));
+    return context;
+}
+
+void testPattern_shouldRenderAllFields()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%d{ISO_MS} [%l] %t %T: %m");
+    L(context, "db").warning() << "Slow query";
+
+    const std::regex lineRegex(R"(^\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3} \[W:\] \d+ db: Slow query\n$)");
+    assert(std::regex_match(ss.str(), lineRegex));
+}
+
+void testPattern_shouldUseContextTimestampModeForPlainDate()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%d|%m");
+    context->setTimestampMode(L::TimestampMode::EpochSeconds);
+    L(context).info() << "Epoch";
+
+    const std::regex lineRegex(R"(^\d{10}\|Epoch\n$)");
+    assert(std::regex_match(ss.str(), lineRegex));
+}
+
+void testPattern_shouldSupportCustomTimestampFormatAndEscapes()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%d{%H:%M} 100%% %x %m%");
+    L(context).info() << "Done";
+
+    const std::regex lineRegex(R"(^\d{2}:\d{2} 100% %x Done%\n$)");
+    assert(std::regex_match(ss.str(), lineRegex));
+}
+
+void testEmptyPattern_shouldRestoreDefaultLayout()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%m");
+    context->setTimestampMode(L::TimestampMode::None);
+    L(context, "TAG").info() << "Custom";
+    context->setPattern("");
+    L(context, "TAG").info() << "Default";
+
+    assert(ss.str() == "Custom\nI: TAG: Default\n");
+}
+
+void testPatternWithCollapse_shouldCollapseRenderedMessages()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%l %T %m");
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+    context->setCollapseRepeatedMessages(true);
+    L(context, "a").info() << "Same";
+    L(context, "b").info() << "Same";
+    L(context, "a").info() << "Same";
+    context->flush();
+
+    assert(ss.str() == "I: a Same (x2)\nI: b Same\n");
+}
+
+static_assert(L::SourceLocation::basenameOffset("/a/b/file.cpp") == 5);
+
+void testSourceLocation_shouldRenderFileLineAndFunction()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%F:%L %M %m");
+    const auto line = __LINE__ + 1;
+    L(context, SIMPLE_LOGGER_HERE).info() << "Here";
+    L(context).info() << "Nowhere";
+
+    assert(ss.str() == "pattern_test.cpp:" + std::to_string(line) + " testSourceLocation_shouldRenderFileLineAndFunction Here\n:  Nowhere\n");
+}
+
+void testThreadName_shouldBeKeptForBatchedMessages()
+{
+    std::stringstream ss;
+    const auto context = createContext(ss, "%N %m");
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+
+    std::thread worker { [&context] {
+        L::setThreadName("worker");
+        L(context).info() << "From worker";
+    } };
+    worker.join();
+
+    L(context).info() << "From main";
+    context->flush();
+
+    assert(ss.str() == "worker From worker\n From main\n");
+}
+
+} // namespace juzzlin::PatternTest
+
+int main()
+{
+    juzzlin::PatternTest::testPattern_shouldRenderAllFields();
+
+    juzzlin::PatternTest::testPattern_shouldUseContextTimestampModeForPlainDate();
+
+    juzzlin::PatternTest::testPattern_shouldSupportCustomTimestampFormatAndEscapes();
+
+    juzzlin::PatternTest::testEmptyPattern_shouldRestoreDefaultLayout();
+
+    juzzlin::PatternTest::testPatternWithCollapse_shouldCollapseRenderedMessages();
+
+    juzzlin::PatternTest::testSourceLocation_shouldRenderFileLineAndFunction();
+
+    juzzlin::PatternTest::testThreadName_shouldBeKeptForBatchedMessages();
+
+    return EXIT_SUCCESS;
+}
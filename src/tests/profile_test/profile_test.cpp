@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::ProfileTest {
+
+class NullSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> &) override
+    {
+    }
+};
+
+L::ContextPtr createContext()
+{
+    L::Config config;
+    config.echoMode = false;
+    const auto context = L::createContext(config);
+    context->addSink(std::make_shared<NullSink>());
+    return context;
+}
+
+const L::CallSiteStats * findCallSite(const std::vector<L::CallSiteStats> & sites, unsigned int line)
+{
+    const auto it = std::find_if(sites.begin(), sites.end(), [line](auto && site) {
+        return site.location.line == line && std::string { site.location.file } == "profile_test.cpp";
+    });
+    return it != sites.end() ? &*it : nullptr;
+}
+
+void testProfiling_shouldCountMessagesPerCallSite()
+{
+    const auto context = createContext();
+    L::enableProfiling(true);
+
+    unsigned int noisyLine = 0;
+    unsigned int quietLine = 0;
+    unsigned int filteredLine = 0;
+    const auto logFromThread = [&] {
+        for (int i = 0; i < 100; i++) {
+            L(context, SIMPLE_LOGGER_HERE).info() << "0123456789";
+            noisyLine = __LINE__ - 1;
+            if (i % 10 == 0) {
+                L(context, SIMPLE_LOGGER_HERE).warning() << "01234";
+                quietLine = __LINE__ - 1;
+            }
+            L(context, SIMPLE_LOGGER_HERE).debug() << "Filtered";
+            filteredLine = __LINE__ - 1;
+        }
+    };
+    // The counters of exited threads are kept
+    std::thread first { logFromThread };
+    first.join();
+    std::thread second { logFromThread };
+    second.join();
+    logFromThread();
+
+    L::enableProfiling(false);
+    L(context, SIMPLE_LOGGER_HERE).info() << "Not counted";
+    const auto notCountedLine = __LINE__ - 1;
+
+    const auto sites = L::profile();
+    const auto noisy = findCallSite(sites, noisyLine);
+    assert(noisy);
+    assert(noisy->emitted == 300);
+    assert(noisy->emittedBytes == 3000);
+    assert(noisy->filtered == 0);
+    assert(noisy->time.count() > 0);
+    assert(std::string { noisy->location.function } == "operator()");
+
+    const auto quiet = findCallSite(sites, quietLine);
+    assert(quiet);
+    assert(quiet->emitted == 30);
+    assert(quiet->emittedBytes == 150);
+
+    const auto filtered = findCallSite(sites, filteredLine);
+    assert(filtered);
+    assert(filtered->emitted == 0);
+    assert(filtered->filtered == 300);
+
+    assert(noisy < quiet && quiet < filtered);
+    assert(!findCallSite(sites, notCountedLine));
+
+    std::ostringstream report;
+    L::writeProfileReport(report);
+    const auto text = report.str();
+    assert(text.find("emitted") < text.find('\n'));
+    assert(text.find("profile_test.cpp:" + std::to_string(noisyLine) + " operator()") != std::string::npos);
+    assert(text.find("profile_test.cpp:" + std::to_string(noisyLine)) < text.find("profile_test.cpp:" + std::to_string(quietLine)));
+}
+
+} // namespace juzzlin::ProfileTest
+
+int main()
+{
+    juzzlin::ProfileTest::testProfiling_shouldCountMessagesPerCallSite();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace juzzlin::SharedMemoryTest {
+
+using Test::CollectingSink;
+
+//! Collecting sink that can hold back the collector.
+class BlockingSink : public CollectingSink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        while (blocked) {
+            std::this_thread::yield();
+        }
+        CollectingSink::write(records);
+    }
+
+    std::atomic<bool> blocked { false };
+};
+
+std::string ringName(const std::string & test)
+{
+    return "/simple_logger_" + test + "_" + std::to_string(::getpid());
+}
+
+L::ContextPtr createContext(const std::string & name, L::SinkOptions::Overflow overflow)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    const auto context = L::createContext(config);
+    context->addSink(L::createSharedMemorySink(name, overflow));
+    return context;
+}
+
+void testForkedProducers_shouldDeliverAllMessagesInOrder()
+{
+    const auto name = ringName("fork");
+    const auto sink = std::make_shared<CollectingSink>();
+    auto collector = L::createSharedMemoryCollector(name, 64 * 1024, sink);
+
+    const int producers = 4;
+    const int messages = 5000;
+    std::vector<pid_t> children;
+    for (int producer = 0; producer < producers; producer++) {
+        const auto pid = ::fork();
+        assert(pid >= 0);
+        if (!pid) {
+            const auto context = createContext(name, L::SinkOptions::Overflow::Block);
+            for (int message = 0; message < messages; message++) {
+                // Vary the length so that records wrap around the ring at different offsets
+                L(context).info() << producer << ":" << message << ":" << std::string(static_cast<size_t>(message % 97), 'x');
+            }
+            std::_Exit(EXIT_SUCCESS);
+        }
+        children.push_back(pid);
+    }
+
+    for (auto && pid : children) {
+        int status = 0;
+        assert(::waitpid(pid, &status, 0) == pid);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+    }
+
+    collector.reset();
+
+    assert(sink->lines().size() == static_cast<size_t>(producers * messages));
+    std::map<int, int> next;
+    for (auto && line : sink->lines()) {
+        int producer = -1;
+        int message = -1;
+        int padding = 0;
+        assert(std::sscanf(line.c_str(), "I: %d:%d:%n", &producer, &message, &padding) == 2);
+        assert(message == next[producer]++);
+        assert(line.substr(static_cast<size_t>(padding)) == std::string(static_cast<size_t>(message % 97), 'x'));
+    }
+    for (int producer = 0; producer < producers; producer++) {
+        assert(next[producer] == messages);
+    }
+}
+
+void testFullRing_shouldDropAndReportMessages()
+{
+    const auto name = ringName("drop");
+    const auto sink = std::make_shared<BlockingSink>();
+    sink->blocked = true;
+    auto collector = L::createSharedMemoryCollector(name, 4096, sink);
+
+    const int messages = 1000;
+    {
+        const auto context = createContext(name, L::SinkOptions::Overflow::Drop);
+        for (int message = 0; message < messages; message++) {
+            L(context).info() << message << std::string(64, 'x');
+        }
+    }
+
+    sink->blocked = false;
+    collector.reset();
+
+    size_t dropped = 0;
+    size_t received = 0;
+    // Each drain that finds drops sends its own notice
+    for (auto && line : sink->lines()) {
+        size_t count = 0;
+        if (std::sscanf(line.c_str(), "SimpleLogger: %zu messages dropped", &count) == 1) {
+            dropped += count;
+        } else {
+            received++;
+        }
+    }
+    assert(dropped);
+    assert(received + dropped == messages);
+}
+
+void testExistingRing_shouldThrow()
+{
+    const auto name = ringName("exists");
+    const auto collector = L::createSharedMemoryCollector(name, 4096, std::make_shared<CollectingSink>());
+    bool thrown = false;
+    try {
+        L::createSharedMemoryCollector(name, 4096, std::make_shared<CollectingSink>());
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void testMissingRing_shouldThrow()
+{
+    bool thrown = false;
+    try {
+        L::createSharedMemorySink(ringName("missing"));
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+} // namespace juzzlin::SharedMemoryTest
+
+int main()
+{
+    juzzlin::SharedMemoryTest::testForkedProducers_shouldDeliverAllMessagesInOrder();
+
+    juzzlin::SharedMemoryTest::testFullRing_shouldDropAndReportMessages();
+
+    juzzlin::SharedMemoryTest::testExistingRing_shouldThrow();
+
+    juzzlin::SharedMemoryTest::testMissingRing_shouldThrow();
+
+    return EXIT_SUCCESS;
+}
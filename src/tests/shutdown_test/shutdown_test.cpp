@@ -0,0 +1,185 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace juzzlin::ShutdownTest {
+
+std::string readFile(const std::string & fileName)
+{
+    std::ifstream fin { fileName };
+    std::stringstream ss;
+    ss << fin.rdbuf();
+    return ss.str();
+}
+
+L::Config batchConfig(const std::string & fileName)
+{
+    L::Config config;
+    config.filename = fileName;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    return config;
+}
+
+//! Run function in a child process.
+//! \return The wait status of the child.
+template<typename Function>
+int runInChild(Function && function)
+{
+    const auto pid = ::fork();
+    assert(pid >= 0);
+    if (!pid) {
+        function();
+        std::_Exit(EXIT_FAILURE);
+    }
+    int status = 0;
+    assert(::waitpid(pid, &status, 0) == pid);
+    return status;
+}
+
+void testLeakedContext_shouldBeDrainedAtExit()
+{
+    const std::string fileName = "shutdown_test_exit.log";
+    const auto status = runInChild([&] {
+        // Never destroyed
+        const auto context = *new L::ContextPtr { L::createContext(batchConfig(fileName)) };
+        L(context).info() << "Queued at exit";
+        std::exit(EXIT_SUCCESS);
+    });
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS);
+    assert(readFile(fileName) == "I: Queued at exit\n");
+}
+
+void testEmergencyFlush_shouldWriteBatchOnSignal()
+{
+    const std::string fileName = "shutdown_test_signal.log";
+    const auto status = runInChild([&] {
+        L::enableEmergencyFlush(true);
+        const auto context = L::createContext(batchConfig(fileName));
+        L(context).error() << "Queued at crash";
+        std::raise(SIGTERM);
+    });
+    assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGTERM);
+    assert(readFile(fileName) == "E: Queued at crash\n");
+}
+
+class BlockingSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        while (blocked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        written += records.size();
+    }
+
+    std::atomic<bool> blocked { true };
+
+    std::atomic<size_t> written { 0 };
+};
+
+void testShutdown_shouldDrainAsyncSinksAndDisableBatching()
+{
+    const std::string fileName = "shutdown_test_shutdown.log";
+    const auto context = L::createContext(batchConfig(fileName));
+    const auto sink = std::make_shared<BlockingSink>();
+    L::SinkOptions options;
+    options.async = true;
+    context->addSink(sink, options);
+
+    L(context).info() << "Queued";
+    assert(!L::shutdown(std::chrono::steady_clock::now() + std::chrono::milliseconds(20)));
+    assert(readFile(fileName) == "I: Queued\n");
+
+    sink->blocked = false;
+    assert(L::shutdown(std::chrono::steady_clock::now() + std::chrono::seconds(5)));
+    assert(sink->written == 1);
+
+    L(context).info() << "Written immediately";
+    assert(readFile(fileName) == "I: Queued\nI: Written immediately\n");
+}
+
+size_t countLines(const std::string & text)
+{
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+}
+
+void testShutdown_shouldDisableAdaptiveBatching()
+{
+    const std::string fileName = "shutdown_test_adaptive.log";
+    auto config = batchConfig(fileName);
+    config.adaptiveBatching.enabled = true;
+    config.adaptiveBatching.maxInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+
+    // A burst is batched
+    for (int i = 0; i < 50; i++) {
+        L(context).info() << "Burst " << i;
+    }
+    assert(countLines(readFile(fileName)) < 50);
+    assert(L::shutdown(std::chrono::steady_clock::now() + std::chrono::seconds(5)));
+    assert(countLines(readFile(fileName)) == 50);
+
+    for (int i = 0; i < 5; i++) {
+        L(context).info() << "After shutdown " << i;
+    }
+    assert(countLines(readFile(fileName)) == 55);
+}
+
+} // namespace juzzlin::ShutdownTest
+
+int main()
+{
+    juzzlin::ShutdownTest::testLeakedContext_shouldBeDrainedAtExit();
+
+    juzzlin::ShutdownTest::testEmergencyFlush_shouldWriteBatchOnSignal();
+
+    juzzlin::ShutdownTest::testShutdown_shouldDrainAsyncSinksAndDisableBatching();
+
+    juzzlin::ShutdownTest::testShutdown_shouldDisableAdaptiveBatching();
+
+    return EXIT_SUCCESS;
+}
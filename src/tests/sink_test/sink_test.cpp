@@ -0,0 +1,289 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::SinkTest {
+
+using Test::CollectingSink;
+
+class SlowSink : public CollectingSink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        CollectingSink::write(records);
+    }
+};
+
+class BlockingSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> & records) override
+    {
+        while (m_blocked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        m_written += records.size();
+    }
+
+    std::atomic<bool> m_blocked { true };
+
+    std::atomic<size_t> m_written { 0 };
+};
+
+class ThrowingSink : public L::Sink
+{
+public:
+    void write(const std::vector<L::Record> &) override
+    {
+        throw std::runtime_error("Sink failed");
+    }
+};
+
+L::ContextPtr createContext()
+{
+    L::Config config;
+    config.echoMode = false;
+    config.level = L::Level::Trace;
+    config.timestampMode = L::TimestampMode::None;
+    return L::createContext(config);
+}
+
+void testLevelFilter_shouldOnlyPassMessagesAtOrAboveSinkLevel()
+{
+    const auto context = createContext();
+    const auto all = std::make_shared<CollectingSink>();
+    const auto errors = std::make_shared<CollectingSink>();
+    context->addSink(all);
+    L::SinkOptions options;
+    options.level = L::Level::Error;
+    context->addSink(errors, options);
+
+    L(context).debug() << "Debug";
+    L(context).error() << "Error";
+
+    assert(all->lines() == std::vector<std::string>({ "D: Debug", "E: Error" }));
+    assert(errors->lines() == std::vector<std::string>({ "E: Error" }));
+}
+
+void testBatch_shouldBeWrittenInOneCall()
+{
+    const auto context = createContext();
+    const auto sink = std::make_shared<CollectingSink>();
+    context->addSink(sink);
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+
+    L(context).info() << "A";
+    L(context).info() << "B";
+    L(context).info() << "C";
+    assert(sink->batches().size() == 0);
+
+    context->flush();
+    assert(sink->batches().size() == 1);
+    assert(sink->lines().size() == 3);
+}
+
+void testBlockedAsyncSink_shouldNotStallOtherSinks()
+{
+    const auto context = createContext();
+    const auto blocking = std::make_shared<BlockingSink>();
+    const auto collecting = std::make_shared<CollectingSink>();
+    L::SinkOptions options;
+    options.async = true;
+    options.queueCapacity = 4;
+    options.overflow = L::SinkOptions::Overflow::Drop;
+    context->addSink(blocking, options);
+    context->addSink(collecting);
+
+    for (int i = 0; i < 100; i++) {
+        L(context).info() << "Message " << i;
+    }
+    assert(collecting->lines().size() == 100);
+
+    blocking->m_blocked = false;
+    context->removeSink(blocking);
+    assert(blocking->m_written > 0);
+    assert(blocking->m_written < 100);
+}
+
+void testAsyncSink_shouldWriteAllMessagesWhenBlockingOnOverflow()
+{
+    const auto context = createContext();
+    const auto sink = std::make_shared<CollectingSink>();
+    L::SinkOptions options;
+    options.async = true;
+    options.queueCapacity = 8;
+    options.overflow = L::SinkOptions::Overflow::Block;
+    context->addSink(sink, options);
+
+    for (int i = 0; i < 1000; i++) {
+        L(context).info() << "Message " << i;
+    }
+    context->removeSink(sink);
+
+    const auto lines = sink->lines();
+    assert(lines.size() == 1000);
+    assert(lines.front() == "I: Message 0");
+    assert(lines.back() == "I: Message 999");
+}
+
+void testAsyncSink_shouldKeepRecordsOfBatchLargerThanQueueWhenBlocking()
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+    const auto sink = std::make_shared<SlowSink>();
+    L::SinkOptions options;
+    options.async = true;
+    options.queueCapacity = 4;
+    options.overflow = L::SinkOptions::Overflow::Block;
+    context->addSink(sink, options);
+
+    // The worker releases the copy of a batch while the rest of it is still being queued
+    for (int batch = 0; batch < 50; batch++) {
+        for (int i = 0; i < 40; i++) {
+            L(context).info() << "Batch " << batch << " message " << i;
+        }
+        context->flush();
+    }
+    context->removeSink(sink);
+
+    const auto lines = sink->lines();
+    assert(lines.size() == 2000);
+    for (size_t i = 0; i < lines.size(); i++) {
+        assert(lines.at(i) == "I: Batch " + std::to_string(i / 40) + " message " + std::to_string(i % 40));
+    }
+}
+
+void testStreamSink_shouldWriteToStream()
+{
+    const auto context = createContext();
+    std::stringstream ss;
+    context->addSink(L::createStreamSink(ss));
+    L(context, "TAG").warning() << "Hello";
+    assert(ss.str() == "W: TAG: Hello\n");
+}
+
+void testFlushAsync_shouldCompleteWhenAsyncSinksHaveWritten()
+{
+    const auto context = createContext();
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+    const auto blocking = std::make_shared<BlockingSink>();
+    const auto collecting = std::make_shared<CollectingSink>();
+    L::SinkOptions options;
+    options.async = true;
+    context->addSink(blocking, options);
+    context->addSink(collecting);
+
+    for (int i = 0; i < 3; i++) {
+        L(context).info() << "Message " << i;
+    }
+
+    auto first = context->flushAsync();
+    auto second = context->flushAsync();
+    assert(first.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+    assert(blocking->m_written == 0);
+
+    blocking->m_blocked = false;
+    first.get();
+    second.get();
+    assert(blocking->m_written == 3);
+    assert(collecting->lines().size() == 3);
+}
+
+void testFlushAsync_shouldCompleteDespiteFailingSink()
+{
+    const auto context = createContext();
+    context->setBatchInterval(std::chrono::milliseconds(60000));
+    context->addSink(std::make_shared<ThrowingSink>());
+    const auto sink = std::make_shared<CollectingSink>();
+    context->addSink(sink);
+
+    L(context).info() << "Message";
+
+    context->flushAsync().get();
+    assert(sink->lines() == std::vector<std::string>({ "I: Message" }));
+}
+
+void testThrowingSyncSink_shouldNotBreakLoggingOrOtherSinks()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    {
+        const auto context = createContext();
+        context->addSink(std::make_shared<ThrowingSink>());
+        context->addSink(sink);
+
+        L(context).info() << "Unbatched";
+        context->setBatchInterval(std::chrono::milliseconds(60000));
+        L(context).info() << "Batched";
+        // The context flushes the batch when destroyed
+    }
+
+    assert(sink->lines() == std::vector<std::string>({ "I: Unbatched", "I: Batched" }));
+}
+
+} // namespace juzzlin::SinkTest
+
+int main()
+{
+    juzzlin::SinkTest::testLevelFilter_shouldOnlyPassMessagesAtOrAboveSinkLevel();
+
+    juzzlin::SinkTest::testBatch_shouldBeWrittenInOneCall();
+
+    juzzlin::SinkTest::testBlockedAsyncSink_shouldNotStallOtherSinks();
+
+    juzzlin::SinkTest::testAsyncSink_shouldWriteAllMessagesWhenBlockingOnOverflow();
+
+    juzzlin::SinkTest::testAsyncSink_shouldKeepRecordsOfBatchLargerThanQueueWhenBlocking();
+
+    juzzlin::SinkTest::testStreamSink_shouldWriteToStream();
+
+    juzzlin::SinkTest::testFlushAsync_shouldCompleteWhenAsyncSinksHaveWritten();
+
+    juzzlin::SinkTest::testFlushAsync_shouldCompleteDespiteFailingSink();
+
+    juzzlin::SinkTest::testThrowingSyncSink_shouldNotBreakLoggingOrOtherSinks();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+#include "../collecting_sink.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace juzzlin::SpanTest {
+
+using Test::CollectingSink;
+
+L::ContextPtr createContext(std::shared_ptr<CollectingSink> sink)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    return context;
+}
+
+std::vector<std::string> readEvents(const std::string & fileName)
+{
+    std::ifstream fin { fileName };
+    std::vector<std::string> events;
+    std::string line;
+    std::getline(fin, line);
+    assert(line == "[");
+    while (std::getline(fin, line) && line != "]") {
+        if (line.back() == ',') {
+            line.pop_back();
+        }
+        events.push_back(line);
+    }
+    assert(line == "]");
+    return events;
+}
+
+const std::string & findEvent(const std::vector<std::string> & events, const std::string & name)
+{
+    for (auto && event : events) {
+        if (event.find(R"({"name":")" + name + '"') == 0) {
+            return event;
+        }
+    }
+    assert(false);
+    return events.front();
+}
+
+double numberField(const std::string & event, const std::string & key)
+{
+    const auto position = event.find('"' + key + "\":");
+    assert(position != std::string::npos);
+    return std::stod(event.substr(position + key.size() + 3));
+}
+
+void testSpanWithoutTraceSink_shouldLogDuration()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    {
+        const auto span = L(context, "db").span("query");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    assert(sink->lines().size() == 1);
+    const auto line = sink->lines().at(0);
+    assert(line.find("I: db: query took ") == 0);
+    assert(line.substr(line.size() - 3) == " ms");
+    assert(std::stod(line.substr(18)) >= 2.0);
+}
+
+void testSpanOfDisabledLevel_shouldBeInactive()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    {
+        const auto span = L(context).span("Hidden", L::Level::Debug);
+    }
+    assert(sink->lines().empty());
+}
+
+void testEndedSpan_shouldBeWrittenOnce()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    {
+        auto span = L(context).span("Step");
+        auto moved = std::move(span);
+        moved.end();
+        moved.end();
+    }
+    assert(sink->lines().size() == 1);
+}
+
+void testSpan_shouldKeepContextAlive()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    auto context = createContext(sink);
+    auto span = L(context).span("Outlives");
+    context.reset();
+
+    span.end();
+    assert(sink->lines().size() == 1);
+    assert(sink->lines().at(0).find("I: Outlives took ") == 0);
+}
+
+void testSpan_shouldUseClockSourceOfStart()
+{
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    {
+        const auto span = L(context).span("Switch");
+        context->setClockSource(L::ClockSource::Tsc);
+    }
+    const auto line = sink->lines().at(0);
+    assert(std::abs(std::stod(line.substr(line.find("took ") + 5))) < 1000.0);
+}
+
+void testTraceSink_shouldWriteNestedCompleteEvents()
+{
+    const std::string fileName = "span_test.json";
+    const auto sink = std::make_shared<CollectingSink>();
+    const auto context = createContext(sink);
+    context->setTraceSink(L::createTraceFileSink(fileName));
+
+    std::thread worker { [&] {
+        L::setThreadName("worker \"1\"");
+        const auto outer = L(context, "db").span("outer");
+        {
+            const auto inner = L(context, "db").span("inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } };
+    worker.join();
+    context->flush();
+    context->setTraceSink(nullptr);
+
+    // Not logged as messages
+    assert(sink->lines().empty());
+
+    const auto events = readEvents(fileName);
+    assert(events.size() == 3);
+    assert(events.at(0).find(R"({"name":"thread_name","ph":"M",)") == 0);
+    assert(events.at(0).find(R"("args":{"name":"worker \"1\""}})") != std::string::npos);
+
+    const auto & outer = findEvent(events, "outer");
+    const auto & inner = findEvent(events, "inner");
+    assert(outer.find(R"("cat":"db","ph":"X")") != std::string::npos);
+    assert(numberField(inner, "tid") == numberField(outer, "tid"));
+    assert(numberField(inner, "ts") >= numberField(outer, "ts"));
+    assert(numberField(inner, "ts") + numberField(inner, "dur") <= numberField(outer, "ts") + numberField(outer, "dur"));
+    assert(numberField(outer, "dur") >= 2000);
+}
+
+} // namespace juzzlin::SpanTest
+
+int main()
+{
+    juzzlin::SpanTest::testSpanWithoutTraceSink_shouldLogDuration();
+
+    juzzlin::SpanTest::testSpanOfDisabledLevel_shouldBeInactive();
+
+    juzzlin::SpanTest::testEndedSpan_shouldBeWrittenOnce();
+
+    juzzlin::SpanTest::testSpan_shouldKeepContextAlive();
+
+    juzzlin::SpanTest::testSpan_shouldUseClockSourceOfStart();
+
+    juzzlin::SpanTest::testTraceSink_shouldWriteNestedCompleteEvents();
+
+    return EXIT_SUCCESS;
+}
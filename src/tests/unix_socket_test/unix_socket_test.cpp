@@ -0,0 +1,223 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "../../simple_logger.hpp"
+
+// Don't compile asserts away
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace juzzlin::UnixSocketTest {
+
+const std::string socketPath = "unix_socket_test.sock";
+
+//! Stand-in for a log collector.
+class Collector
+{
+public:
+    explicit Collector(int type)
+      : m_socket { ::socket(AF_UNIX, type, 0) }
+    {
+        ::unlink(socketPath.c_str());
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, socketPath.c_str());
+        assert(::bind(m_socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0);
+        if (type == SOCK_STREAM) {
+            assert(::listen(m_socket, 1) == 0);
+        }
+    }
+
+    ~Collector()
+    {
+        if (m_connection >= 0) {
+            ::close(m_connection);
+        }
+        ::close(m_socket);
+        ::unlink(socketPath.c_str());
+    }
+
+    //! Read octet counted frames from the accepted connection.
+    std::vector<std::string> readFrames(size_t count)
+    {
+        if (m_connection < 0) {
+            assert(waitReadable(m_socket));
+            m_connection = ::accept(m_socket, nullptr, nullptr);
+            assert(m_connection >= 0);
+        }
+
+        std::vector<std::string> frames;
+        while (frames.size() < count) {
+            const auto space = m_buffer.find(' ');
+            if (space != std::string::npos) {
+                const auto length = std::stoul(m_buffer.substr(0, space));
+                if (m_buffer.size() >= space + 1 + length) {
+                    frames.push_back(m_buffer.substr(space + 1, length));
+                    m_buffer.erase(0, space + 1 + length);
+                    continue;
+                }
+            }
+            assert(waitReadable(m_connection));
+            char data[4096];
+            const auto received = ::read(m_connection, data, sizeof(data));
+            assert(received > 0);
+            m_buffer.append(data, static_cast<size_t>(received));
+        }
+        return frames;
+    }
+
+    std::vector<std::string> readDatagrams(size_t count)
+    {
+        std::vector<std::string> datagrams;
+        while (datagrams.size() < count) {
+            assert(waitReadable(m_socket));
+            char data[4096];
+            const auto received = ::recv(m_socket, data, sizeof(data), 0);
+            assert(received >= 0);
+            datagrams.emplace_back(data, static_cast<size_t>(received));
+        }
+        return datagrams;
+    }
+
+private:
+    static bool waitReadable(int fd)
+    {
+        pollfd pfd { fd, POLLIN, 0 };
+        return ::poll(&pfd, 1, 5000) == 1;
+    }
+
+    int m_socket;
+
+    int m_connection = -1;
+
+    std::string m_buffer;
+};
+
+L::ContextPtr createContext(L::SinkPtr sink)
+{
+    L::Config config;
+    config.echoMode = false;
+    config.timestampMode = L::TimestampMode::None;
+    config.batchInterval = std::chrono::milliseconds(60000);
+    const auto context = L::createContext(config);
+    context->addSink(sink);
+    return context;
+}
+
+void testStreamSocket_shouldSendOctetCountedFrames()
+{
+    Collector collector { SOCK_STREAM };
+    const auto context = createContext(L::createUnixSocketSink(socketPath));
+
+    L(context).info() << "Hello";
+    L(context).warning() << "Multi\nline";
+    L(context).error() << std::string(10000, 'x');
+    context->flush();
+
+    const auto frames = collector.readFrames(3);
+    assert(frames[0] == "I: Hello");
+    assert(frames[1] == "W: Multi\nline");
+    assert(frames[2] == "E: " + std::string(10000, 'x'));
+}
+
+void testDatagramSocket_shouldSendOneDatagramPerRecord()
+{
+    Collector collector { SOCK_DGRAM };
+    const auto context = createContext(L::createUnixSocketSink(socketPath, L::SocketType::Datagram));
+
+    L(context).info() << "One";
+    L(context).info() << "Two";
+    context->flush();
+
+    assert(collector.readDatagrams(2) == std::vector<std::string>({ "I: One", "I: Two" }));
+}
+
+void testCollectorRestart_shouldSendSpilledRecordsAfterReconnecting()
+{
+    ::unlink(socketPath.c_str());
+    const auto context = createContext(L::createUnixSocketSink(socketPath, L::SocketType::Stream, 32));
+
+    for (int i = 0; i < 10; i++) {
+        L(context).info() << "Spilled " << i;
+    }
+    context->flush();
+
+    Collector collector { SOCK_STREAM };
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    L(context).info() << "Connected";
+    context->flush();
+
+    const auto frames = collector.readFrames(4);
+    assert(frames[0] == "SimpleLogger: 8 messages dropped");
+    assert(frames[1] == "I: Spilled 8");
+    assert(frames[2] == "I: Spilled 9");
+    assert(frames[3] == "I: Connected");
+}
+
+void testFlush_shouldSendSpilledRecordsWithoutNewMessages()
+{
+    ::unlink(socketPath.c_str());
+    const auto context = createContext(L::createUnixSocketSink(socketPath, L::SocketType::Stream, 32));
+
+    L(context).info() << "Spilled";
+    context->flush();
+
+    Collector collector { SOCK_STREAM };
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    context->flush();
+
+    const auto frames = collector.readFrames(1);
+    assert(frames[0] == "I: Spilled");
+}
+
+} // namespace juzzlin::UnixSocketTest
+
+int main()
+{
+    juzzlin::UnixSocketTest::testStreamSocket_shouldSendOctetCountedFrames();
+
+    juzzlin::UnixSocketTest::testDatagramSocket_shouldSendOneDatagramPerRecord();
+
+    juzzlin::UnixSocketTest::testCollectorRestart_shouldSendSpilledRecordsAfterReconnecting();
+
+    juzzlin::UnixSocketTest::testFlush_shouldSendSpilledRecordsWithoutNewMessages();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "simple_logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using juzzlin::L;
+
+namespace {
+
+void printUsage()
+{
+    std::cerr << "Usage: simple_logger_query [--from TIME] [--to TIME] [--level LEVEL] FILE" << std::endl
+              << std::endl
+              << "Print records of a file written by SimpleLogger's block file sink." << std::endl
+              << std::endl
+              << "  TIME   Milliseconds since the epoch or local time YYYY-MM-DDTHH:MM:SS" << std::endl
+              << "  LEVEL  Minimum level: trace, debug, info, warning, error, fatal" << std::endl;
+}
+
+std::chrono::system_clock::time_point parseTime(const std::string & value)
+{
+    if (value.find('T') == std::string::npos) {
+        return std::chrono::system_clock::time_point { std::chrono::milliseconds { std::stoll(value) } };
+    }
+
+    std::tm localTime {};
+    if (std::sscanf(value.c_str(), "%d-%d-%dT%d:%d:%d", &localTime.tm_year, &localTime.tm_mon, &localTime.tm_mday, &localTime.tm_hour, &localTime.tm_min, &localTime.tm_sec) != 6) {
+        throw std::invalid_argument("Invalid time: " + value);
+    }
+    localTime.tm_year -= 1900;
+    localTime.tm_mon -= 1;
+    localTime.tm_isdst = -1;
+    return std::chrono::system_clock::from_time_t(std::mktime(&localTime));
+}
+
+L::Level parseLevel(const std::string & value)
+{
+    static const std::map<std::string, L::Level> levels = {
+        { "trace", L::Level::Trace },
+        { "debug", L::Level::Debug },
+        { "info", L::Level::Info },
+        { "warning", L::Level::Warning },
+        { "error", L::Level::Error },
+        { "fatal", L::Level::Fatal }
+    };
+
+    if (const auto level = levels.find(value); level != levels.end()) {
+        return level->second;
+    }
+    throw std::invalid_argument("Invalid level: " + value);
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    L::BlockFileQuery query;
+    std::string fileName;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (argument == "--from" && i + 1 < argc) {
+                query.from = parseTime(argv[++i]);
+            } else if (argument == "--to" && i + 1 < argc) {
+                query.to = parseTime(argv[++i]);
+            } else if (argument == "--level" && i + 1 < argc) {
+                query.level = parseLevel(argv[++i]);
+            } else if (fileName.empty() && argument.rfind("--", 0) != 0) {
+                fileName = argument;
+            } else {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (fileName.empty()) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        L::queryBlockFile(fileName, query, [](const L::Record & record) {
+            std::cout << record.text << '\n';
+        });
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,525 @@
+// MIT License
+//
+// Copyright (c) 2026 Jussi Lind <jussi.lind@iki.fi>
+//
+// https://github.com/juzzlin/SimpleLogger
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "simple_logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using juzzlin::L;
+
+namespace {
+
+void printUsage()
+{
+    std::cerr << "Usage: simple_logger_replay [OPTIONS] FILE" << std::endl
+              << std::endl
+              << "Replay a text log written by SimpleLogger with the default layout and report the throughput," << std::endl
+              << "the latency of the log statements and the bytes written for each logger configuration." << std::endl
+              << std::endl
+              << "  --timestamp-mode MODE  none, datetime, iso, iso_ms, epoch_s, epoch_ms, epoch_us, custom (default: datetime)" << std::endl
+              << "  --separator TEXT       Timestamp separator (default: \": \")" << std::endl
+              << "  --symbol LEVEL=TEXT    Level symbol, e.g. info=I: (default: T: D: I: W: E: F:)" << std::endl
+              << "  --threads N            Replay on N threads (default: 1)" << std::endl
+              << "  --realtime             Keep the original timing between messages" << std::endl
+              << "  --config NAME          Configuration to run, can be repeated (default: all)" << std::endl
+              << "  --output FILE          Log file written during the replay (default: in the temporary directory)" << std::endl
+              << std::endl
+              << "Configurations: direct, batched, collapse, adaptive, async" << std::endl;
+}
+
+//! A message parsed from the log.
+struct Entry
+{
+    L::Level level = L::Level::Info;
+
+    std::string tag;
+
+    std::string message;
+
+    //! Timestamp as time since the epoch, if it could be parsed.
+    std::optional<std::chrono::microseconds> time;
+
+    //! Offset from the first message.
+    std::chrono::microseconds offset {};
+};
+
+//! Layout of the log to parse.
+struct Format
+{
+    L::TimestampMode timestampMode = L::TimestampMode::DateTime;
+
+    std::string separator = ": ";
+
+    //! Same defaults as in the logger.
+    std::map<L::Level, std::string> symbols = {
+        { L::Level::Trace, "T:" },
+        { L::Level::Debug, "D:" },
+        { L::Level::Info, "I:" },
+        { L::Level::Warning, "W:" },
+        { L::Level::Error, "E:" },
+        { L::Level::Fatal, "F:" }
+    };
+};
+
+L::TimestampMode parseTimestampMode(const std::string & value)
+{
+    static const std::map<std::string, L::TimestampMode> modes = {
+        { "none", L::TimestampMode::None },
+        { "datetime", L::TimestampMode::DateTime },
+        { "iso", L::TimestampMode::ISODateTime },
+        { "iso_ms", L::TimestampMode::ISODateTimeMilliseconds },
+        { "epoch_s", L::TimestampMode::EpochSeconds },
+        { "epoch_ms", L::TimestampMode::EpochMilliseconds },
+        { "epoch_us", L::TimestampMode::EpochMicroseconds },
+        { "custom", L::TimestampMode::Custom }
+    };
+
+    if (const auto mode = modes.find(value); mode != modes.end()) {
+        return mode->second;
+    }
+    throw std::invalid_argument("Invalid timestamp mode: " + value);
+}
+
+L::Level parseLevel(const std::string & value)
+{
+    static const std::map<std::string, L::Level> levels = {
+        { "trace", L::Level::Trace },
+        { "debug", L::Level::Debug },
+        { "info", L::Level::Info },
+        { "warning", L::Level::Warning },
+        { "error", L::Level::Error },
+        { "fatal", L::Level::Fatal }
+    };
+
+    if (const auto level = levels.find(value); level != levels.end()) {
+        return level->second;
+    }
+    throw std::invalid_argument("Invalid level: " + value);
+}
+
+std::chrono::microseconds fromLocalTime(std::tm localTime, int milliseconds)
+{
+    localTime.tm_isdst = -1;
+    const auto time = std::chrono::system_clock::from_time_t(std::mktime(&localTime)) + std::chrono::milliseconds { milliseconds };
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch());
+}
+
+//! \return Length of the timestamp at the start of the line, or 0 if there's none.
+size_t timestampLength(const std::string & line, const Format & format)
+{
+    switch (format.timestampMode) {
+    case L::TimestampMode::None:
+        return 0;
+    case L::TimestampMode::DateTime:
+        return 24; // "%a %b %e %H:%M:%S %Y"
+    case L::TimestampMode::ISODateTime:
+        return 19; // "%Y-%m-%dT%H:%M:%S"
+    case L::TimestampMode::ISODateTimeMilliseconds:
+        return 23;
+    case L::TimestampMode::EpochSeconds:
+    case L::TimestampMode::EpochMilliseconds:
+    case L::TimestampMode::EpochMicroseconds: {
+        size_t length = 0;
+        while (length < line.size() && line[length] >= '0' && line[length] <= '9') {
+            length++;
+        }
+        return length;
+    }
+    case L::TimestampMode::Custom:
+        // The format is unknown, so the timestamp is assumed to end at the first separator
+        if (const auto position = line.find(format.separator); position != std::string::npos && !format.separator.empty()) {
+            return position;
+        }
+        return 0;
+    }
+    return 0;
+}
+
+//! \return Time since the epoch, or nothing if the timestamp can't be parsed.
+std::optional<std::chrono::microseconds> parseTimestamp(const std::string & text, L::TimestampMode timestampMode)
+{
+    static const std::array<std::string, 12> months = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+    std::tm localTime {};
+    int milliseconds = 0;
+    switch (timestampMode) {
+    case L::TimestampMode::DateTime: {
+        std::array<char, 4> month {};
+        if (std::sscanf(text.c_str(), "%*3s %3s %d %d:%d:%d %d", month.data(), &localTime.tm_mday, &localTime.tm_hour, &localTime.tm_min, &localTime.tm_sec, &localTime.tm_year) != 6) {
+            return {};
+        }
+        const auto index = std::find(months.begin(), months.end(), month.data());
+        if (index == months.end()) {
+            return {};
+        }
+        localTime.tm_mon = static_cast<int>(index - months.begin());
+        localTime.tm_year -= 1900;
+        return fromLocalTime(localTime, 0);
+    }
+    case L::TimestampMode::ISODateTimeMilliseconds:
+    case L::TimestampMode::ISODateTime: {
+        const auto fields = std::sscanf(text.c_str(), "%d-%d-%dT%d:%d:%d.%d", &localTime.tm_year, &localTime.tm_mon, &localTime.tm_mday, &localTime.tm_hour, &localTime.tm_min, &localTime.tm_sec, &milliseconds);
+        if (fields < (timestampMode == L::TimestampMode::ISODateTime ? 6 : 7)) {
+            return {};
+        }
+        localTime.tm_year -= 1900;
+        localTime.tm_mon -= 1;
+        return fromLocalTime(localTime, milliseconds);
+    }
+    case L::TimestampMode::EpochSeconds:
+        return std::chrono::seconds { std::stoll(text) };
+    case L::TimestampMode::EpochMilliseconds:
+        return std::chrono::milliseconds { std::stoll(text) };
+    case L::TimestampMode::EpochMicroseconds:
+        return std::chrono::microseconds { std::stoll(text) };
+    default:
+        return {};
+    }
+}
+
+/*!
+ * Parse a line in the default layout: [timestamp + separator][symbol][ tag:] message.
+ * A word ending with ':' right after the symbol is taken as the tag.
+ * \return The entry, or nothing if the line doesn't start a new message.
+ */
+std::optional<Entry> parseLine(const std::string & line, const Format & format)
+{
+    size_t position = 0;
+    std::optional<std::chrono::microseconds> time;
+    if (format.timestampMode != L::TimestampMode::None) {
+        position = timestampLength(line, format);
+        if (!position || position > line.size() || line.compare(position, format.separator.size(), format.separator)) {
+            return {};
+        }
+        const auto timestamp = line.substr(0, position);
+        time = parseTimestamp(timestamp, format.timestampMode);
+        if (!time && format.timestampMode != L::TimestampMode::Custom) {
+            return {};
+        }
+        position += format.separator.size();
+    }
+
+    // The longest matching symbol wins in case one symbol is a prefix of another
+    std::optional<L::Level> level;
+    size_t symbolSize = 0;
+    for (auto && [symbolLevel, symbol] : format.symbols) {
+        if (symbol.size() >= symbolSize && !line.compare(position, symbol.size(), symbol)) {
+            level = symbolLevel;
+            symbolSize = symbol.size();
+        }
+    }
+    if (!level) {
+        return {};
+    }
+    position += symbolSize;
+
+    Entry entry;
+    entry.level = *level;
+    entry.time = time;
+    if (position < line.size() && line[position] == ' ') {
+        position++;
+        const auto end = line.find(' ', position);
+        if (end != std::string::npos && end > position + 1 && line[end - 1] == ':') {
+            entry.tag = line.substr(position, end - position - 1);
+            position = end + 1;
+        }
+    }
+    entry.message = line.substr(std::min(position, line.size()));
+    return entry;
+}
+
+std::vector<Entry> readLog(const std::string & fileName, const Format & format)
+{
+    std::ifstream file { fileName };
+    if (!file) {
+        throw std::runtime_error("ERROR!!: Couldn't open '" + fileName + "' for read.\n");
+    }
+
+    std::vector<Entry> entries;
+    std::optional<std::chrono::microseconds> first;
+    std::chrono::microseconds previous {};
+    std::string line;
+    while (std::getline(file, line)) {
+        if (auto entry = parseLine(line, format)) {
+            // Entries without a parsable time and backward jumps of the clock keep the previous offset
+            if (entry->time) {
+                if (!first) {
+                    first = entry->time;
+                }
+                previous = std::max(previous, *entry->time - *first);
+            }
+            entry->offset = previous;
+            entries.push_back(std::move(*entry));
+        } else if (!entries.empty()) {
+            // Continuation of a multi-line message
+            entries.back().message += '\n';
+            entries.back().message += line;
+        }
+    }
+    return entries;
+}
+
+//! A logger configuration to measure.
+struct Configuration
+{
+    std::string name;
+
+    L::Config config;
+
+    L::SinkOptions sinkOptions;
+};
+
+std::vector<Configuration> configurations(L::TimestampMode timestampMode)
+{
+    L::Config base;
+    base.echoMode = false;
+    base.level = L::Level::Trace;
+    base.timestampMode = timestampMode == L::TimestampMode::Custom ? L::TimestampMode::DateTime : timestampMode;
+
+    std::vector<Configuration> result;
+    result.push_back({ "direct", base, {} });
+
+    auto batched = base;
+    batched.batchInterval = std::chrono::milliseconds(100);
+    result.push_back({ "batched", batched, {} });
+
+    auto collapse = batched;
+    collapse.collapseRepeatedMessages = true;
+    result.push_back({ "collapse", collapse, {} });
+
+    auto adaptive = base;
+    adaptive.adaptiveBatching.enabled = true;
+    result.push_back({ "adaptive", adaptive, {} });
+
+    L::SinkOptions async;
+    async.async = true;
+    async.queueCapacity = 65536;
+    async.overflow = L::SinkOptions::Overflow::Block;
+    result.push_back({ "async", base, async });
+
+    return result;
+}
+
+void log(const L::ContextPtr & context, const Entry & entry)
+{
+    L logger { context, entry.tag };
+    switch (entry.level) {
+    case L::Level::Trace:
+        logger.trace() << entry.message;
+        break;
+    case L::Level::Debug:
+        logger.debug() << entry.message;
+        break;
+    case L::Level::Info:
+        logger.info() << entry.message;
+        break;
+    case L::Level::Warning:
+        logger.warning() << entry.message;
+        break;
+    case L::Level::Error:
+        logger.error() << entry.message;
+        break;
+    default:
+        logger.fatal() << entry.message;
+        break;
+    }
+}
+
+struct Result
+{
+    std::chrono::nanoseconds elapsed {};
+
+    //! Latencies of the log statements, sorted.
+    std::vector<std::chrono::nanoseconds> latencies;
+
+    uintmax_t bytes = 0;
+};
+
+Result replay(const std::vector<Entry> & entries, const Configuration & configuration, size_t threadCount, bool realtime, const std::string & outputFile)
+{
+    std::filesystem::remove(outputFile);
+
+    Result result;
+    std::vector<std::vector<std::chrono::nanoseconds>> latencies(threadCount);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const auto context = L::createContext(configuration.config);
+        context->addSink(L::createFileSink(outputFile), configuration.sinkOptions);
+
+        // Messages are dealt to the threads in turn, so each thread gets a similar mix
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < threadCount; thread++) {
+            threads.emplace_back([&, thread] {
+                auto && threadLatencies = latencies.at(thread);
+                threadLatencies.reserve(entries.size() / threadCount + 1);
+                for (size_t i = thread; i < entries.size(); i += threadCount) {
+                    if (realtime) {
+                        std::this_thread::sleep_until(start + entries[i].offset);
+                    }
+                    const auto begin = std::chrono::steady_clock::now();
+                    log(context, entries[i]);
+                    threadLatencies.push_back(std::chrono::steady_clock::now() - begin);
+                }
+            });
+        }
+        for (auto && thread : threads) {
+            thread.join();
+        }
+        // Also waits for the asynchronous sinks
+        context->flushAsync().get();
+    }
+    result.elapsed = std::chrono::steady_clock::now() - start;
+
+    for (auto && threadLatencies : latencies) {
+        result.latencies.insert(result.latencies.end(), threadLatencies.begin(), threadLatencies.end());
+    }
+    std::sort(result.latencies.begin(), result.latencies.end());
+
+    result.bytes = std::filesystem::file_size(outputFile);
+    std::filesystem::remove(outputFile);
+    return result;
+}
+
+double percentile(const std::vector<std::chrono::nanoseconds> & sorted, double percent)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto index = std::min(sorted.size() - 1, static_cast<size_t>(static_cast<double>(sorted.size()) * percent / 100));
+    return std::chrono::duration<double, std::micro> { sorted[index] }.count();
+}
+
+void printResult(const std::string & name, size_t messages, const Result & result)
+{
+    const auto seconds = std::chrono::duration<double> { result.elapsed }.count();
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed
+              << std::setw(14) << std::setprecision(0) << (seconds > 0 ? static_cast<double>(messages) / seconds : 0)
+              << std::setprecision(2)
+              << std::setw(10) << percentile(result.latencies, 50)
+              << std::setw(10) << percentile(result.latencies, 90)
+              << std::setw(10) << percentile(result.latencies, 99)
+              << std::setw(10) << percentile(result.latencies, 99.9)
+              << std::setw(12) << percentile(result.latencies, 100)
+              << std::setw(14) << result.bytes << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    Format format;
+    size_t threadCount = 1;
+    bool realtime = false;
+    std::vector<std::string> names;
+    std::string outputFile = (std::filesystem::temp_directory_path() / "simple_logger_replay.log").string();
+    std::string fileName;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            if (argument == "--timestamp-mode" && i + 1 < argc) {
+                format.timestampMode = parseTimestampMode(argv[++i]);
+            } else if (argument == "--separator" && i + 1 < argc) {
+                format.separator = argv[++i];
+            } else if (argument == "--symbol" && i + 1 < argc) {
+                const std::string value = argv[++i];
+                const auto equals = value.find('=');
+                if (equals == std::string::npos) {
+                    throw std::invalid_argument("Invalid symbol: " + value);
+                }
+                format.symbols[parseLevel(value.substr(0, equals))] = value.substr(equals + 1);
+            } else if (argument == "--threads" && i + 1 < argc) {
+                threadCount = std::max(1, std::stoi(argv[++i]));
+            } else if (argument == "--realtime") {
+                realtime = true;
+            } else if (argument == "--config" && i + 1 < argc) {
+                names.emplace_back(argv[++i]);
+            } else if (argument == "--output" && i + 1 < argc) {
+                outputFile = argv[++i];
+            } else if (fileName.empty() && argument.rfind("--", 0) != 0) {
+                fileName = argument;
+            } else {
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (fileName.empty()) {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+
+        auto selected = configurations(format.timestampMode);
+        for (auto && name : names) {
+            if (std::none_of(selected.begin(), selected.end(), [&name](auto && configuration) { return configuration.name == name; })) {
+                throw std::invalid_argument("Invalid configuration: " + name);
+            }
+        }
+        if (!names.empty()) {
+            selected.erase(std::remove_if(selected.begin(), selected.end(), [&names](auto && configuration) {
+                               return std::find(names.begin(), names.end(), configuration.name) == names.end();
+                           }),
+                           selected.end());
+        }
+
+        const auto entries = readLog(fileName, format);
+        if (entries.empty()) {
+            throw std::runtime_error("ERROR!!: No messages found in '" + fileName + "'. Check the timestamp mode and the symbols.\n");
+        }
+        std::cout << entries.size() << " messages, " << threadCount << " thread(s)" << (realtime ? ", original timing" : "") << std::endl
+                  << std::endl
+                  << std::left << std::setw(10) << "config" << std::right
+                  << std::setw(14) << "messages/s"
+                  << std::setw(10) << "p50 us"
+                  << std::setw(10) << "p90 us"
+                  << std::setw(10) << "p99 us"
+                  << std::setw(10) << "p99.9 us"
+                  << std::setw(12) << "max us"
+                  << std::setw(14) << "bytes" << std::endl;
+
+        for (auto && configuration : selected) {
+            printResult(configuration.name, entries.size(), replay(entries, configuration, threadCount, realtime, outputFile));
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}